@@ -22,10 +22,23 @@
 #define NULL (void *) 0		/* por si acaso no esta ya definida */
 #endif
 
-#define MAX_PROC 10		/* dimension de tabla de procesos */
+#define MAX_PROC 4096		/* dimension maxima de tabla de procesos */
+#define PROCS_POR_BLOQUE 64	/* la tabla crece de bloque en bloque */
+#define MAX_GENERACION (0x7fffffff / MAX_PROC) /* usos de una entrada
+						  antes de repetir ids. */
 
 #define TAM_PILA 32768
 
+/* pilas y entradas de la tabla de procesos preparadas de antemano (se
+   puede cambiar en el arranque con la variable de entorno
+   RESERVA_PROCESOS) */
+#define RESERVA_PROCESOS 64
+
+/* procesos terminados cuyos recursos libera como mucho el recolector en
+   cada tick si hay procesos ejecutando (la tarea ociosa los recoge de uno
+   en uno) */
+#define RECOGIDOS_POR_TICK 4
+
 
 /*
  * Posibles estados del proceso
@@ -35,6 +48,12 @@
 #define LISTO 1
 #define EJECUCION 2
 #define BLOQUEADO 3
+#define ZOMBI 4		/* terminado, hasta que su padre recoja su estado */
+
+/* valor de terminacion de un proceso que termina sin indicarlo
+   (terminar_proceso o vuelta de main) y de uno abortado por el S.O. */
+#define ESTADO_FIN_NORMAL 0
+#define ESTADO_FIN_ANORMAL -1
 
 /*
  * Niveles de ejecuci�n del procesador. 
@@ -64,9 +83,68 @@
 /* frecuencia de reloj requerida (ticks/segundo) */
 #define TICK 1000
 
+/* si vale 1, el reloj se ralentiza cuando no hace falta tratar cada tick */
+#define TICK_DINAMICO 1
+
+/* si vale 1, con todos los procesos bloqueados el reloj salta al siguiente
+   despertar (se puede cambiar en el arranque con la variable de entorno
+   TIEMPO_VIRTUAL) */
+#define TIEMPO_VIRTUAL 0
+
+/* holgura de los despertares de procesos dormidos, en ticks (sin holgura
+   salvo que el proceso la pida con fijar_holgura) */
+#define HOLGURA_DEFECTO 0
+#define MAX_HOLGURA TICK
+
+/* constantes usadas en la cache de imagenes de programas */
+#define MAX_IMAGENES 32 /* programas distintos cargados a la vez */
+#define MAX_NOM_PROG 32 /* longitud maxima del nombre de un programa */
+
+/* numero total de temporizadores en el sistema */
+#define MAX_TEMPORIZADORES 16
+
 /* constante usada en implementacion de round robin */
 #define TICKS_POR_RODAJA 1
 
+/* constantes usadas en la planificacion por prioridades */
+#define NUM_PRIORIDADES 32 /* niveles (caben en el mapa de bits de listos) */
+#define PRIORIDAD_MAXIMA 0
+#define PRIORIDAD_MINIMA (NUM_PRIORIDADES - 1)
+#define PRIORIDAD_DEFECTO 16
+
+/* politicas de planificacion disponibles */
+#define PLANIF_PRIORIDADES 0 /* prioridades fijas, RR dentro de cada nivel */
+#define PLANIF_MLFQ 1        /* colas multinivel con realimentacion */
+#define PLANIF_CFS 2         /* reparto equitativo por tiempo virtual */
+#define PLANIF_STRIDE 3      /* reparto proporcional por zancadas */
+#define PLANIF_FIFO 4        /* orden de llegada, sin expulsion */
+#define PLANIF_RR 5          /* turno rotatorio con una unica cola */
+#define NUM_POLITICAS 6
+
+#define POLITICA_PLANIF PLANIF_PRIORIDADES /* politica por defecto */
+
+/* constantes usadas en la planificacion MLFQ */
+#define NIVELES_MLFQ 5 /* el nivel i usa una rodaja de TICKS_POR_RODAJA*4^i */
+#define PERIODO_BOOST_MLFQ 1000 /* ticks entre subidas al nivel 0 */
+
+/* constantes usadas en la planificacion CFS */
+#define LATENCIA_CFS 20 /* ticks en los que deben ejecutar todos los listos */
+#define GRANULARIDAD_CFS 4 /* rodaja minima en ticks */
+#define TIEMPO_VIRTUAL_TICK 1024 /* unidades de tiempo virtual por tick */
+
+/* constantes usadas en la planificacion por zancadas (stride) */
+#define ZANCADA_BASE (1 << 20) /* zancada = ZANCADA_BASE / tickets */
+#define TICKETS_DEFECTO 100
+#define MAX_TICKETS 10000
+#define RODAJA_STRIDE 5 /* ticks entre decisiones de reparto */
+
+/* constante usada en el control de admision de tiempo real */
+#define UTILIZACION_MAXIMA 1000000 /* 100% de utilizacion de la UCP */
+
+/* constantes usadas en los grupos de procesos con cuota de UCP */
+#define MAX_GRUPOS 8
+#define PERIODO_GRUPOS 100 /* ticks del periodo de contabilidad de cuotas */
+
 /* constantes usada en implementacion de mutex */
 #define NUM_MUT 16 /* numero total de mutex en el sistema */
 #define NUM_MUT_PROC 4 /* numero maximo de mutex que puede tener
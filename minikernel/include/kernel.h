@@ -22,6 +22,7 @@
 #include "const.h"
 #include "HAL.h"
 #include "llamsis.h"
+#include "pagina_sistema.h"
 
 /*
  *
@@ -31,7 +32,22 @@
  */
 typedef struct BCP_t *BCPptr;
 
+/*
+ *
+ * Definicion del tipo que corresponde con la cabecera de una lista
+ * de BCPs. Este tipo se puede usar para diversas listas (procesos listos,
+ * procesos bloqueados en sem�foro, etc.).
+ *
+ */
+
+typedef struct {
+    BCPptr primero;
+    BCPptr ultimo;
+} lista_BCPs;
 
+/*
+ * Definicion del BCP propiamente dicho.
+ */
 typedef struct BCP_t {
     int id;                /* ident. del proceso */
     int estado;            /* TERMINADO|LISTO|EJECUCION|BLOQUEADO*/
@@ -39,9 +55,12 @@ typedef struct BCP_t {
     void *pila;            /* dir. inicial de la pila */
     BCPptr siguiente;        /* puntero a otro BCP */
     void *info_mem;            /* descriptor del mapa de memoria */
+    unsigned int generacion;   /* usos previos de esta entrada de la tabla:
+                                  id = generacion * MAX_PROC + entrada */
 
-    //TODO nuevo campo contador de segundos
-    unsigned int segundosDormido;    /*Segundos que tiene que estar dormido el proceso*/
+    //TODO nuevo campo tick de despertar
+    unsigned long long despertar;    /*Tick absoluto en que debe despertar el proceso dormido*/
+    unsigned int holgura;         /* ticks que se puede retrasar su despertar */
 
     //TODO nuevos campos mutex
     int descriptoresMutex[NUM_MUT_PROC]; /*Lista de descriptores de mutex asociada al proceso*/
@@ -49,21 +68,137 @@ typedef struct BCP_t {
     //TODO ticks restantes en la rodaja
     unsigned int ticksRestantes;
 
+    int prioridad;                /* nivel de prioridad (0 = maxima); en
+                                     MLFQ es el nivel de realimentacion */
+
+    unsigned long long tiempo_virtual; /* UCP consumida ponderada (CFS) */
+    unsigned int tickets;         /* cuota de UCP relativa (zancadas) */
+    unsigned int zancada;         /* ZANCADA_BASE / tickets */
+    unsigned long long pase;      /* avance acumulado por zancadas */
+    int tiempo_real;              /* admitido en la clase de tiempo real */
+    unsigned int periodo;         /* periodo de activacion en ticks */
+    unsigned int presupuesto;     /* ticks de UCP permitidos por periodo */
+    unsigned int presupuesto_restante; /* ticks que le quedan este periodo */
+    unsigned long long plazo;     /* tick absoluto del plazo actual */
+    unsigned long long utilizacion; /* presupuesto/periodo (UTILIZACION_MAXIMA = 100%) */
+    int estrangulado;             /* ha agotado el presupuesto del periodo */
+    unsigned int fallos_plazo;    /* trabajos terminados fuera de plazo */
+    unsigned int excesos_presupuesto; /* periodos con presupuesto agotado */
+    unsigned long long clave_monticulo; /* orden en el monticulo de listos */
+    int pos_monticulo;            /* posicion en el monticulo o -1 */
+    int grupo;                    /* grupo de procesos o -1 */
+    unsigned long long tiempo_ucp; /* ticks de UCP consumidos */
+    unsigned int limite_blando;   /* aviso al superarlo (0 = sin limite) */
+    unsigned int limite_duro;     /* se termina al alcanzarlo (0 = sin limite) */
+    int aviso_limite;             /* ya se ha avisado del limite blando */
+    unsigned int avisos_pendientes; /* vencimientos de sus temporizadores
+                                       con funcion aun no atendidos */
+    BCPptr padre;                 /* proceso que lo creo o NULL si es
+                                     huerfano (nadie lo va a esperar) */
+    unsigned int num_hijos;       /* hijos vivos o zombis */
+    int estado_fin;               /* valor de terminacion (de un zombi) */
+    lista_BCPs esperando_fin;     /* bloqueados en esperar_proceso */
+    void *funcion_hilo;           /* funcion y argumento de un hilo (NULL
+                                     si es un proceso) */
+    void *arg_hilo;
+    int por_recoger;              /* terminado, en lista_por_recoger */
+
 } BCP;
 
+/*
+ *
+ * Definicion del tipo que corresponde con un grupo de procesos que
+ * comparte una cuota de UCP por periodo de PERIODO_GRUPOS ticks. Los
+ * listos de un grupo que ha agotado la cuota esperan en estrangulados
+ * hasta el siguiente periodo.
+ *
+ */
+
+typedef struct {
+    int usado;                  /* grupo creado */
+    unsigned int cuota;         /* ticks por periodo (0 = sin limite) */
+    unsigned int consumido;     /* ticks consumidos en el periodo actual */
+    unsigned long long total;   /* ticks consumidos desde su creacion */
+    int estrangulado;           /* ha agotado la cuota del periodo */
+    lista_BCPs estrangulados;   /* listos retirados hasta el siguiente periodo */
+} grupo_procs;
+
 
 /*
  *
- * Definicion del tipo que corresponde con la cabecera de una lista
- * de BCPs. Este tipo se puede usar para diversas listas (procesos listos,
- * procesos bloqueados en sem�foro, etc.).
+ * Definicion del tipo que corresponde con un monticulo binario de BCPs
+ * ordenado por clave_monticulo. Se usa para los listos en CFS y stride,
+ * para los de tiempo real y para los dormidos.
  *
  */
 
 typedef struct {
-    BCP *primero;
-    BCP *ultimo;
-} lista_BCPs;
+    BCP *elems[MAX_PROC];
+    int num;
+} monticulo_BCPs;
+
+/*
+ *
+ * Definicion del tipo que corresponde con una clase de planificacion.
+ * Cada politica implementa estas operaciones sobre su conjunto de listos
+ * y la que se usa se elige en el arranque (variable de entorno
+ * PLANIFICADOR).
+ *
+ */
+
+typedef struct {
+    char *nombre;
+    void (*encolar)(BCP *proc);         /* pasa a listo */
+    void (*desencolar)(BCP *proc);      /* deja de estar listo */
+    BCP *(*elegir_siguiente)();         /* siguiente a ejecutar o NULL */
+    void (*tick)(BCP *proc, unsigned int ticks); /* UCP consumida */
+    int (*ceder)(BCP *proc, int agotada); /* el actual debe dejar la UCP? */
+    int (*expulsa)(BCP *nuevo, BCP *actual); /* un nuevo listo expulsa? */
+    void (*iniciar)(BCP *proc);         /* valores de un proceso nuevo */
+    int tick_prescindible;              /* con un solo ejecutable no
+                                           necesita cada tick */
+    void (*encolar_lote)(lista_BCPs *lote); /* pasan a listo varios
+                                               nuevos (NULL = de uno en
+                                               uno con encolar) */
+} clase_planif;
+
+/*
+ *
+ * Definicion del tipo que corresponde con un temporizador de un proceso.
+ * Los armados forman una lista ordenada por tick de vencimiento que el
+ * reloj revisa junto con los dormidos. Al vencer, si tiene funcion se
+ * avisa al proceso para que la biblioteca la ejecute; si no, se cuenta el
+ * vencimiento y se despierta al proceso si lo esta esperando.
+ *
+ */
+typedef struct temporizador_t *temporizadorptr;
+
+typedef struct temporizador_t {
+    int usado;                  /* temporizador creado */
+    BCP *proceso;               /* proceso propietario */
+    unsigned long long vencimiento; /* tick absoluto del siguiente
+                                       vencimiento (0 = desarmado) */
+    unsigned int periodo;       /* ticks entre vencimientos (0 = una vez) */
+    void (*funcion)(int);       /* funcion de usuario o NULL (contador) */
+    unsigned int vencimientos;  /* vencimientos aun no consumidos */
+    int esperando;              /* el propietario esta bloqueado en el */
+    temporizadorptr siguiente;  /* siguiente en la lista de armados */
+} temporizador;
+
+/*
+ *
+ * Definicion del tipo que corresponde con una entrada de la cache de
+ * imagenes: un programa cargado que comparten todos sus procesos
+ *
+ */
+typedef struct {
+    char nombre[MAX_NOM_PROG];  /* programa ("" si solo la comparten
+                                   hilos) */
+    void *imagen;               /* descriptor del mapa de memoria */
+    void *pc_inicial;           /* punto de entrada */
+    unsigned int referencias;   /* procesos e hilos que la usan
+                                   (0 = libre) */
+} imagen_cache;
 
 
 typedef struct Mutex_t {
@@ -90,22 +225,169 @@ typedef struct Mutex_t *Mutexptr;
 BCP *p_proc_actual = NULL;
 
 /*
- * Variable global que representa la tabla de procesos
+ * Variable global que representa la tabla de procesos: bloques de
+ * PROCS_POR_BLOQUE BCPs que se reservan segun hacen falta, la lista de
+ * entradas libres y el numero de bloques reservados. De cada bloque se
+ * lleva la cuenta de entradas en uso, para que la tarea ociosa devuelva el
+ * ultimo cuando queda libre, y la generacion con la que se vuelven a
+ * crear sus entradas, para no repetir los identificadores ya usados.
+ */
+
+BCP *tabla_procs[MAX_PROC / PROCS_POR_BLOQUE];
+
+lista_BCPs lista_BCPs_libres = {NULL, NULL};
+
+unsigned int num_BCPs_libres = 0;
+
+int num_bloques_procs = 0;
+
+unsigned int BCPs_usados_bloque[MAX_PROC / PROCS_POR_BLOQUE];
+
+unsigned int generacion_bloque[MAX_PROC / PROCS_POR_BLOQUE];
+
+/*
+ * Variable global que representa el BCP de la tarea ociosa, que ejecuta
+ * en modo sistema cuando no hay ningun proceso listo. No esta en la tabla
+ * de procesos y nunca pasa a EJECUCION, de modo que el reloj no le
+ * contabiliza rodajas.
  */
+BCP bcp_ocioso;
 
-BCP tabla_procs[MAX_PROC];
+/*
+ * Ticks que la UCP ha pasado en la tarea ociosa
+ */
+unsigned long long ticks_ociosos = 0;
+
+/*
+ * Cola de procesos terminados cuyos recursos (mutex, imagen, pila...)
+ * estan pendientes de que los libere el recolector
+ */
+lista_BCPs lista_por_recoger = {NULL, NULL};
+
+/*
+ * Reserva de pilas preparadas para crear procesos y tamano que se
+ * mantiene (tambien numero minimo de entradas de la tabla de procesos)
+ */
+void *pilas_libres[MAX_PROC];
+int num_pilas_libres = 0;
+
+unsigned int reserva_procesos = RESERVA_PROCESOS;
 
 /*
- * Variable global que representa la cola de procesos listos
+ * Variable global que representa la cache de imagenes de programas y sus
+ * contadores de aciertos y fallos
+ */
+imagen_cache cache_imagenes[MAX_IMAGENES];
+
+unsigned int aciertos_imagenes = 0;
+unsigned int fallos_imagenes = 0;
+
+/*
+ * Variable global que representa la cola de procesos listos de las
+ * politicas FIFO y RR
  */
 lista_BCPs lista_listos = {NULL, NULL};
 
+/*
+ * Variable global que representa las colas de procesos listos, una por
+ * nivel de prioridad. El proceso en ejecucion no esta en ninguna de ellas.
+ */
+lista_BCPs colas_listos[NUM_PRIORIDADES];
+
+/*
+ * Mapa de bits de colas de listos no vacias: el bit i esta activo si
+ * colas_listos[i] tiene algun proceso
+ */
+unsigned int mapa_listos = 0;
+
+/*
+ * Variable global que representa el monticulo de procesos listos en CFS
+ * y el minimo tiempo virtual del sistema, que solo puede crecer
+ */
+monticulo_BCPs monticulo_listos = {{NULL}, 0};
+
+unsigned long long tiempo_virtual_min = 0;
+
+/*
+ * Pase global de la planificacion por zancadas: minimo pase de los
+ * procesos ejecutables, que solo puede crecer
+ */
+unsigned long long pase_global = 0;
+
+/*
+ * Variable global que representa el monticulo de procesos de tiempo real
+ * listos, ordenado por plazo (EDF), y la utilizacion que tienen admitida
+ */
+monticulo_BCPs monticulo_tiempo_real = {{NULL}, 0};
+
+unsigned long long utilizacion_tiempo_real = 0;
+
+/*
+ * Ticks de reloj transcurridos desde el arranque
+ */
+unsigned long long ticks_sistema = 0;
+
+/*
+ * Pagina del sistema: vista escribible del nucleo y vista de solo lectura
+ * que se publica en la imagen de cada proceso
+ */
+pagina_sistema_t *pagina_nucleo = NULL;
+pagina_sistema_t *pagina_usuario = NULL;
+
+/*
+ * Tick dinamico: si esta activo y ticks que representa cada interrupcion
+ * de reloj con la frecuencia programada actualmente
+ */
+int tick_dinamico = TICK_DINAMICO;
+
+unsigned int ticks_por_int = 1;
+
+/*
+ * Tiempo virtual: si esta activo, con todos los procesos bloqueados el
+ * reloj salta al siguiente despertar en vez de esperarlo
+ */
+int tiempo_virtual = TIEMPO_VIRTUAL;
+
+/*
+ * Variable global que representa la tabla de grupos de procesos y ticks
+ * transcurridos en el periodo de contabilidad de cuotas actual
+ */
+grupo_procs grupos[MAX_GRUPOS];
+
+unsigned int ticks_periodo_grupos = 0;
+
+/*
+ * Variable global que indica la politica de planificacion en uso
+ */
+int politica_planif = POLITICA_PLANIF;
+
+/*
+ * Clase de planificacion de los procesos que no son de tiempo real
+ */
+clase_planif *clase_normal = NULL;
+
+/*
+ * Ticks transcurridos desde la ultima subida de todos los procesos al
+ * nivel 0 en la politica MLFQ
+ */
+unsigned int ticks_desde_boost = 0;
+
 
 //TODO Nueva lista dormidos
 /*
- * Variable global que representa la cola de procesos dormidos
+ * Variable global que representa la cola de procesos dormidos: monticulo
+ * ordenado por el tick absoluto de despertar, de modo que el reloj solo
+ * mira la cima
  */
-lista_BCPs lista_dormidos = {NULL, NULL};
+monticulo_BCPs monticulo_dormidos = {{NULL}, 0};
+
+/*
+ * Variable global que representa la tabla de temporizadores y la lista de
+ * los armados, ordenada por tick de vencimiento
+ */
+temporizador temporizadores[MAX_TEMPORIZADORES];
+
+temporizadorptr lista_temporizadores = NULL;
 
 //TODO nueva lista de mutex del sistema
 Mutexptr lista_mutex[NUM_MUT];
@@ -133,8 +415,18 @@ typedef struct {
  */
 int sis_crear_proceso();
 
+int sis_crear_procesos();
+
+int sis_esperar_proceso();
+
+int sis_crear_hilo();
+
+int sis_argumentos_hilo();
+
 int sis_terminar_proceso();
 
+int sis_terminar_proceso_estado();
+
 int sis_escribir();
 
 //TODO servicios dormir
@@ -155,6 +447,48 @@ int sis_cerrar_mutex();
 
 int sis_leer_caracter();
 
+int sis_fijar_prioridad();
+
+int sis_fijar_tickets();
+
+int sis_fijar_tiempo_real();
+
+int sis_esperar_periodo();
+
+int sis_ceder_cpu();
+
+int sis_ceder_a();
+
+int sis_crear_grupo();
+
+int sis_unir_grupo();
+
+int sis_leer_uso_grupo();
+
+int sis_fijar_limite_ucp();
+
+int sis_leer_tiempo_ucp();
+
+int sis_leer_tiempo_ocioso();
+
+int sis_dormir_ms();
+
+int sis_dormir_hasta();
+
+int sis_fijar_holgura();
+
+int sis_obtener_ticks();
+
+int sis_crear_temporizador();
+
+int sis_esperar_temporizador();
+
+int sis_cancelar_temporizador();
+
+int sis_recoger_aviso();
+
+int sis_leer_cache_imagenes();
+
 
 /*
  * Variable global que contiene las rutinas que realizan cada llamada
@@ -170,7 +504,33 @@ servicio tabla_servicios[NSERVICIOS] = {{sis_crear_proceso},
                                         {sis_lock},
                                         {sis_unlock},
                                         {sis_cerrar_mutex},
-                                        {sis_leer_caracter}};
+                                        {sis_leer_caracter},
+                                        {sis_fijar_prioridad},
+                                        {sis_fijar_tickets},
+                                        {sis_fijar_tiempo_real},
+                                        {sis_esperar_periodo},
+                                        {sis_ceder_cpu},
+                                        {sis_ceder_a},
+                                        {sis_crear_grupo},
+                                        {sis_unir_grupo},
+                                        {sis_leer_uso_grupo},
+                                        {sis_fijar_limite_ucp},
+                                        {sis_leer_tiempo_ucp},
+                                        {sis_leer_tiempo_ocioso},
+                                        {sis_dormir_ms},
+                                        {sis_dormir_hasta},
+                                        {sis_fijar_holgura},
+                                        {sis_obtener_ticks},
+                                        {sis_crear_temporizador},
+                                        {sis_esperar_temporizador},
+                                        {sis_cancelar_temporizador},
+                                        {sis_recoger_aviso},
+                                        {sis_leer_cache_imagenes},
+                                        {sis_crear_procesos},
+                                        {sis_esperar_proceso},
+                                        {sis_crear_hilo},
+                                        {sis_argumentos_hilo},
+                                        {sis_terminar_proceso_estado}};
 
 #endif /* _KERNEL_H */
 
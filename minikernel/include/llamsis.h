@@ -19,7 +19,7 @@
 #define _LLAMSIS_H
 
 /* Numero de llamadas disponibles */
-#define NSERVICIOS 11
+#define NSERVICIOS 37
 
 #define CREAR_PROCESO 0
 #define TERMINAR_PROCESO 1
@@ -32,6 +32,32 @@
 #define UNLOCK 8
 #define CERRAR_MUTEX 9
 #define LEER_CARACTER 10
+#define FIJAR_PRIORIDAD 11
+#define FIJAR_TICKETS 12
+#define FIJAR_TIEMPO_REAL 13
+#define ESPERAR_PERIODO 14
+#define CEDER_CPU 15
+#define CEDER_A 16
+#define CREAR_GRUPO 17
+#define UNIR_GRUPO 18
+#define LEER_USO_GRUPO 19
+#define FIJAR_LIMITE_UCP 20
+#define LEER_TIEMPO_UCP 21
+#define LEER_TIEMPO_OCIOSO 22
+#define DORMIR_MS 23
+#define DORMIR_HASTA 24
+#define FIJAR_HOLGURA 25
+#define OBTENER_TICKS 26
+#define CREAR_TEMPORIZADOR 27
+#define ESPERAR_TEMPORIZADOR 28
+#define CANCELAR_TEMPORIZADOR 29
+#define RECOGER_AVISO 30
+#define LEER_CACHE_IMAGENES 31
+#define CREAR_PROCESOS 32
+#define ESPERAR_PROCESO 33
+#define CREAR_HILO 34
+#define ARGUMENTOS_HILO 35
+#define TERMINAR_PROCESO_ESTADO 36
 
 #endif /* _LLAMSIS_H */
 
@@ -0,0 +1,34 @@
+/*
+ *  minikernel/include/pagina_sistema.h
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ *
+ * Fichero de cabecera que define la pagina del sistema: una pagina de
+ * solo lectura compartida con todos los procesos en la que el nucleo
+ * publica el reloj, el proceso en ejecucion y sus avisos de temporizador
+ * pendientes, para que la biblioteca de usuario los lea sin hacer
+ * llamadas al sistema. El reloj se actualiza en
+ * cada interrupcion de reloj, por lo que con el tick dinamico puede ir
+ * retrasado mientras ejecuta un proceso solo; obtener_ticks lo pone al dia.
+ *
+ */
+
+#ifndef _PAGINA_SISTEMA_H
+#define _PAGINA_SISTEMA_H
+
+typedef struct {
+    /* impar mientras el nucleo actualiza ticks y hora: el lector repite
+       la lectura si cambia o es impar */
+    volatile unsigned int secuencia;
+    volatile unsigned long long ticks; /* ticks desde el arranque */
+    volatile unsigned long long hora;  /* reloj CMOS en milisegundos */
+    volatile int id_actual;            /* proceso en ejecucion */
+    volatile unsigned int avisos;      /* sus avisos de temporizador
+                                          pendientes de atender */
+} pagina_sistema_t;
+
+#endif /* _PAGINA_SISTEMA_H */
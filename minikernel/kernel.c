@@ -17,135 +17,1788 @@
 #include <string.h> /*Funciones para trabajo con cadenas */
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/time.h> /* getitimer para el tick dinamico */
+#include <sys/mman.h> /* mmap para la pagina del sistema */
+#include <unistd.h>
+#include <dlfcn.h>
+
+/*
+ *
+ * Funciones que facilitan el manejo de las listas de BCPs
+ *	insertar_ultimo eliminar_primero eliminar_elem concatenar_lista
+ *
+ * NOTA: PRIMERO SE DEBE LLAMAR A eliminar Y LUEGO A insertar
+ */
+
+/*
+ * Inserta un BCP al final de la lista.
+ */
+static void insertar_ultimo(lista_BCPs *lista, BCP *proc) {
+    if (lista->primero == NULL)
+        lista->primero = proc;
+    else
+        lista->ultimo->siguiente = proc;
+    lista->ultimo = proc;
+    proc->siguiente = NULL;
+}
+
+/*
+ * Elimina el primer BCP de la lista.
+ */
+static void eliminar_primero(lista_BCPs *lista) {
+
+    if (lista->ultimo == lista->primero)
+        lista->ultimo = NULL;
+    lista->primero = lista->primero->siguiente;
+}
+
+/*
+ * Mueve todos los BCPs de la lista origen al final de la lista destino,
+ * dejando vacia la lista origen.
+ */
+static void concatenar_lista(lista_BCPs *destino, lista_BCPs *origen) {
+    if (origen->primero == NULL)
+        return;
+    if (destino->primero == NULL)
+        destino->primero = origen->primero;
+    else
+        destino->ultimo->siguiente = origen->primero;
+    destino->ultimo = origen->ultimo;
+    origen->primero = NULL;
+    origen->ultimo = NULL;
+}
+
+/*
+ * Elimina un determinado BCP de la lista.
+ */
+static void eliminar_elem(lista_BCPs *lista, BCP *proc) {
+    BCP *paux = lista->primero;
+
+    if (paux == proc)
+        eliminar_primero(lista);
+    else {
+        for (; ((paux) && (paux->siguiente != proc));
+               paux = paux->siguiente);
+        if (paux) {
+            if (lista->ultimo == paux->siguiente)
+                lista->ultimo = paux;
+            paux->siguiente = paux->siguiente->siguiente;
+        }
+    }
+}
 
 /*
  *
  * Funciones relacionadas con la tabla de procesos:
- *	iniciar_tabla_proc buscar_BCP_libre
+ *	ampliar_tabla_proc sobra_bloque_procs reducir_tabla_proc
+ *	iniciar_tabla_proc entrada_tabla_proc buscar_BCP_libre
+ *	reservar_BCPs liberar_BCP buscar_proceso
+ *	liberar_zombi abandonar_hijos
+ *
+ */
+
+/*
+ * Funcion que anade a la tabla de procesos un bloque de
+ * PROCS_POR_BLOQUE entradas libres. Los BCPs no se mueven al crecer la
+ * tabla, ya que los apuntan las listas y los monticulos.
+ */
+static int ampliar_tabla_proc() {
+    BCP *bloque;
+    int i;
+
+    if (num_bloques_procs == MAX_PROC / PROCS_POR_BLOQUE)
+        return -1;
+    bloque = calloc(PROCS_POR_BLOQUE, sizeof(BCP));
+    if (bloque == NULL)
+        return -1;
+    for (i = 0; i < PROCS_POR_BLOQUE; i++) {
+        bloque[i].estado = NO_USADA;
+        bloque[i].generacion = generacion_bloque[num_bloques_procs];
+        bloque[i].id = bloque[i].generacion * MAX_PROC +
+                       num_bloques_procs * PROCS_POR_BLOQUE + i;
+        insertar_ultimo(&lista_BCPs_libres, &bloque[i]);
+    }
+    num_BCPs_libres += PROCS_POR_BLOQUE;
+    BCPs_usados_bloque[num_bloques_procs] = 0;
+    tabla_procs[num_bloques_procs++] = bloque;
+    return 0;
+}
+
+/*
+ * Funcion que indica si sobra el ultimo bloque de la tabla de procesos:
+ * no tiene ninguna entrada en uso y sin el sigue habiendo entradas para la
+ * reserva de procesos. Solo se puede quitar el ultimo, ya que la posicion
+ * en la tabla forma parte del identificador.
+ */
+static int sobra_bloque_procs() {
+    return num_bloques_procs > 1 &&
+           BCPs_usados_bloque[num_bloques_procs - 1] == 0 &&
+           (unsigned int) (num_bloques_procs - 1) * PROCS_POR_BLOQUE >=
+           reserva_procesos;
+}
+
+/*
+ * Funcion que devuelve el ultimo bloque de la tabla de procesos, que no
+ * debe tener entradas en uso (ver sobra_bloque_procs)
+ */
+static void reducir_tabla_proc() {
+    BCP *bloque, *proc, *anterior = NULL;
+    unsigned int generacion = 0;
+    int i;
+
+    /* saca sus entradas de la lista de libres en una sola pasada */
+    bloque = tabla_procs[num_bloques_procs - 1];
+    for (proc = lista_BCPs_libres.primero; proc != NULL;
+         proc = proc->siguiente) {
+        if (proc >= bloque && proc < bloque + PROCS_POR_BLOQUE) {
+            if (anterior == NULL)
+                lista_BCPs_libres.primero = proc->siguiente;
+            else
+                anterior->siguiente = proc->siguiente;
+        } else
+            anterior = proc;
+    }
+    lista_BCPs_libres.ultimo = anterior;
+    num_BCPs_libres -= PROCS_POR_BLOQUE;
+
+    /* si se vuelve a crear, sus entradas siguen por la generacion mas
+       alta a la que han llegado */
+    for (i = 0; i < PROCS_POR_BLOQUE; i++)
+        if (bloque[i].generacion > generacion)
+            generacion = bloque[i].generacion;
+    if (++generacion == MAX_GENERACION)
+        generacion = 0;
+    generacion_bloque[--num_bloques_procs] = generacion;
+    tabla_procs[num_bloques_procs] = NULL;
+    free(bloque);
+}
+
+/*
+ * Funcion que inicia la tabla de procesos con un primer bloque
+ */
+static void iniciar_tabla_proc() {
+    if (ampliar_tabla_proc() < 0)
+        panico("no se puede crear la tabla de procesos");
+}
+
+/*
+ * Funcion que devuelve la entrada i-esima de la tabla de procesos
+ */
+static BCP *entrada_tabla_proc(int i) {
+    return &(tabla_procs[i / PROCS_POR_BLOQUE][i % PROCS_POR_BLOQUE]);
+}
+
+/*
+ * Funcion que toma un BCP de la lista de libres, ampliando la tabla si
+ * esta vacia. Devuelve NULL si la tabla ya tiene MAX_PROC entradas.
+ */
+static BCP *buscar_BCP_libre() {
+    BCP *proc;
+
+    if (lista_BCPs_libres.primero == NULL && ampliar_tabla_proc() < 0)
+        return NULL;
+    proc = lista_BCPs_libres.primero;
+    eliminar_primero(&lista_BCPs_libres);
+    num_BCPs_libres--;
+    BCPs_usados_bloque[(proc->id % MAX_PROC) / PROCS_POR_BLOQUE]++;
+    return proc;
+}
+
+/*
+ * Funcion que toma a la vez n BCPs de la lista de libres, ampliando la
+ * tabla si hace falta, y los deja encadenados en "lote". Si no hay
+ * suficientes no toma ninguno y devuelve -1.
+ */
+static int reservar_BCPs(unsigned int n, lista_BCPs *lote) {
+    BCP *proc;
+    unsigned int i;
+
+    while (num_BCPs_libres < n)
+        if (ampliar_tabla_proc() < 0)
+            return -1;
+    lote->primero = lista_BCPs_libres.primero;
+    for (i = 1, proc = lote->primero;; i++) {
+        BCPs_usados_bloque[(proc->id % MAX_PROC) / PROCS_POR_BLOQUE]++;
+        if (i == n)
+            break;
+        proc = proc->siguiente;
+    }
+    lote->ultimo = proc;
+    lista_BCPs_libres.primero = proc->siguiente;
+    if (lista_BCPs_libres.primero == NULL)
+        lista_BCPs_libres.ultimo = NULL;
+    proc->siguiente = NULL;
+    num_BCPs_libres -= n;
+    return 0;
+}
+
+/*
+ * Funcion que devuelve un BCP a la lista de libres. Se anade al
+ * final, para que tarde en reutilizarse, y con el identificador de su
+ * siguiente generacion, de modo que el identificador del proceso que lo
+ * usaba deja de ser valido.
+ */
+static void liberar_BCP(BCP *proc) {
+    int indice = proc->id % MAX_PROC;
+
+    proc->estado = NO_USADA;
+    if (++proc->generacion == MAX_GENERACION)
+        proc->generacion = 0;
+    proc->id = proc->generacion * MAX_PROC + indice;
+    insertar_ultimo(&lista_BCPs_libres, proc);
+    num_BCPs_libres++;
+    BCPs_usados_bloque[indice / PROCS_POR_BLOQUE]--;
+}
+
+/*
+ * Funci�n que devuelve el BCP de un proceso existente o NULL si no existe
+ * (o si el identificador es de una generacion anterior de su entrada)
+ */
+static BCP *buscar_proceso(int id) {
+    int indice;
+    BCP *proc;
+
+    if (id < 0)
+        return NULL;
+    indice = id % MAX_PROC;
+    if (indice >= num_bloques_procs * PROCS_POR_BLOQUE)
+        return NULL;
+    proc = entrada_tabla_proc(indice);
+    if (proc->estado == NO_USADA || proc->id != id)
+        return NULL;
+    return proc;
+}
+
+/*
+ * Funcion que libera el BCP de un zombi cuyo estado ya no va a recoger
+ * nadie. Si el recolector aun no ha liberado sus recursos solo lo deja
+ * huerfano y sera el recolector quien libere el BCP.
+ */
+static void liberar_zombi(BCP *proc) {
+    proc->padre = NULL;
+    if (proc->por_recoger)
+        proc->estado = TERMINADO;
+    else
+        liberar_BCP(proc);
+}
+
+/*
+ * Funcion que deja huerfanos a los hijos de un proceso terminado (la usa
+ * el recolector): los zombis ya no los va a recoger nadie y se liberan, y
+ * los vivos se liberaran al terminar. Solo recorre la tabla si tiene algun
+ * hijo.
+ */
+static void abandonar_hijos(BCP *padre) {
+    BCP *proc;
+    int i;
+
+    for (i = 0; padre->num_hijos > 0 &&
+                i < num_bloques_procs * PROCS_POR_BLOQUE; i++) {
+        proc = entrada_tabla_proc(i);
+        if (proc->estado == NO_USADA || proc->padre != padre)
+            continue;
+        padre->num_hijos--;
+        if (proc->estado == ZOMBI)
+            liberar_zombi(proc);
+        else
+            proc->padre = NULL;
+    }
+}
+
+/*
+ *
+ * Funciones que manejan un monticulo binario de BCPs ordenado por
+ * clave_monticulo (a igual clave, por id para que sea determinista)
+ *	insertar_monticulo eliminar_monticulo cima_monticulo
+ *
+ * Cada BCP guarda su posicion en pos_monticulo, por lo que insertar y
+ * eliminar cualquier elemento son O(log n).
+ */
+
+/*
+ * Devuelve verdadero si el BCP a debe ir por delante del b
+ */
+static int precede_monticulo(BCP *a, BCP *b) {
+    if (a->clave_monticulo != b->clave_monticulo)
+        return a->clave_monticulo < b->clave_monticulo;
+    return a->id < b->id;
+}
+
+/*
+ * Coloca un BCP en la posicion indicada actualizando su pos_monticulo
+ */
+static void colocar_monticulo(monticulo_BCPs *mont, int pos, BCP *proc) {
+    mont->elems[pos] = proc;
+    proc->pos_monticulo = pos;
+}
+
+/*
+ * Restaura el orden del monticulo a partir de la posicion indicada
+ */
+static void reordenar_monticulo(monticulo_BCPs *mont, int pos) {
+    BCP *proc = mont->elems[pos];
+    int hijo;
+
+    /* flota mientras preceda a su padre */
+    while (pos > 0 && precede_monticulo(proc, mont->elems[(pos - 1) / 2])) {
+        colocar_monticulo(mont, pos, mont->elems[(pos - 1) / 2]);
+        pos = (pos - 1) / 2;
+    }
+    /* se hunde mientras algun hijo le preceda */
+    while ((hijo = 2 * pos + 1) < mont->num) {
+        if (hijo + 1 < mont->num &&
+            precede_monticulo(mont->elems[hijo + 1], mont->elems[hijo]))
+            hijo++;
+        if (!precede_monticulo(mont->elems[hijo], proc))
+            break;
+        colocar_monticulo(mont, pos, mont->elems[hijo]);
+        pos = hijo;
+    }
+    colocar_monticulo(mont, pos, proc);
+}
+
+/*
+ * Inserta un BCP en el monticulo
+ */
+static void insertar_monticulo(monticulo_BCPs *mont, BCP *proc) {
+    colocar_monticulo(mont, mont->num++, proc);
+    reordenar_monticulo(mont, proc->pos_monticulo);
+}
+
+/*
+ * Elimina un determinado BCP del monticulo
+ */
+static void eliminar_monticulo(monticulo_BCPs *mont, BCP *proc) {
+    int pos = proc->pos_monticulo;
+
+    mont->num--;
+    if (pos != mont->num) {
+        colocar_monticulo(mont, pos, mont->elems[mont->num]);
+        reordenar_monticulo(mont, pos);
+    }
+    proc->pos_monticulo = -1;
+}
+
+/*
+ * Devuelve el primer BCP del monticulo o NULL si esta vacio
+ */
+static BCP *cima_monticulo(monticulo_BCPs *mont) {
+    if (mont->num == 0)
+        return NULL;
+    return mont->elems[0];
+}
+
+/*
+ *
+ * Funciones relacionadas con la planificacion
+ *	espera_int planificador
+ */
+
+/*
+ * Espera a que se produzca una interrupcion
+ */
+static void espera_int() {
+    int nivel;
+
+    /* Baja al m�nimo el nivel de interrupci�n mientras espera */
+    nivel = fijar_nivel_int(NIVEL_1);
+    halt();
+    fijar_nivel_int(nivel);
+}
+
+/*
+ *
+ * Clases de planificacion. Cada politica implementa las operaciones de
+ * clase_planif (encolar, desencolar, elegir_siguiente, tick, ceder,
+ * expulsa e iniciar) sobre su propio conjunto de listos, y el resto del
+ * nucleo solo las usa a traves de insertar_listo, eliminar_listo,
+ * planificador, comprobar_expulsion e int_sw/int_reloj.
+ *
+ *	FIFO y RR: una unica cola lista_listos
+ *	prioridades y MLFQ: una cola por nivel y el mapa de bits mapa_listos
+ *	    de niveles no vacios, por lo que elegir es O(1)
+ *	CFS y zancadas (stride): monticulo ordenado por tiempo virtual o pase
+ *	tiempo real: monticulo ordenado por plazo (EDF); siempre se elige
+ *	    antes que la clase normal seleccionada en el arranque
+ */
+
+/*
+ * Descuenta ticks de la rodaja del proceso en ejecucion y pide una int. SW
+ * cuando la agota
+ */
+static void consumir_rodaja(BCP *proc, unsigned int ticks) {
+    if (proc->ticksRestantes > ticks)
+        proc->ticksRestantes -= ticks;
+    else
+        proc->ticksRestantes = 0;
+    if (proc->ticksRestantes == 0)
+        activar_int_SW();
+}
+
+/*
+ * Clases FIFO y round-robin: una unica cola de listos. FIFO nunca
+ * expulsa; RR expulsa al agotar la rodaja si hay otro listo.
+ */
+static void encolar_fifo(BCP *proc) {
+    insertar_ultimo(&lista_listos, proc);
+}
+
+static void desencolar_fifo(BCP *proc) {
+    eliminar_elem(&lista_listos, proc);
+}
+
+static BCP *elegir_fifo() {
+    return lista_listos.primero;
+}
+
+static void tick_fifo(BCP *proc, unsigned int ticks) {
+}
+
+static int ceder_fifo(BCP *proc, int agotada) {
+    return 0;
+}
+
+static int expulsa_fifo(BCP *nuevo, BCP *actual) {
+    return 0;
+}
+
+static void iniciar_fifo(BCP *proc) {
+    proc->ticksRestantes = TICKS_POR_RODAJA;
+}
+
+static void encolar_lote_fifo(lista_BCPs *lote) {
+    concatenar_lista(&lista_listos, lote);
+}
+
+static void tick_rr(BCP *proc, unsigned int ticks) {
+    consumir_rodaja(proc, ticks);
+}
+
+static int ceder_rr(BCP *proc, int agotada) {
+    if (agotada)
+        proc->ticksRestantes = TICKS_POR_RODAJA;
+    return agotada && lista_listos.primero != NULL;
+}
+
+/*
+ * Clases de prioridades fijas y MLFQ: una cola por nivel. En MLFQ el
+ * nivel es el campo prioridad, la rodaja crece con el nivel de modo que
+ * los procesos intensivos en UCP bajan a niveles con rodajas largas y
+ * sufren menos cambios de contexto, y cada PERIODO_BOOST_MLFQ ticks todos
+ * vuelven al nivel 0.
+ */
+
+/*
+ * Devuelve el nivel mas prioritario con procesos listos o -1 si no hay
+ */
+static int nivel_max_listo() {
+    if (mapa_listos == 0)
+        return -1;
+    return __builtin_ctz(mapa_listos);
+}
+
+static void encolar_prio(BCP *proc) {
+    insertar_ultimo(&colas_listos[proc->prioridad], proc);
+    mapa_listos |= 1U << proc->prioridad;
+}
+
+/* los procesos de un lote son nuevos y empiezan todos en el mismo nivel */
+static void encolar_lote_prio(lista_BCPs *lote) {
+    int nivel = lote->primero->prioridad;
+
+    concatenar_lista(&colas_listos[nivel], lote);
+    mapa_listos |= 1U << nivel;
+}
+
+static void desencolar_prio(BCP *proc) {
+    lista_BCPs *cola = &colas_listos[proc->prioridad];
+
+    eliminar_elem(cola, proc);
+    if (cola->primero == NULL)
+        mapa_listos &= ~(1U << proc->prioridad);
+}
+
+static BCP *elegir_prio() {
+    if (mapa_listos == 0)
+        return NULL;
+    return colas_listos[nivel_max_listo()].primero;
+}
+
+static void tick_prio(BCP *proc, unsigned int ticks) {
+    consumir_rodaja(proc, ticks);
+}
+
+static int ceder_prio(BCP *proc, int agotada) {
+    int nivel_listo = nivel_max_listo();
+
+    if (agotada)
+        proc->ticksRestantes = TICKS_POR_RODAJA;
+    if (nivel_listo == -1 || nivel_listo > proc->prioridad)
+        return 0;
+    return nivel_listo < proc->prioridad || agotada;
+}
+
+static int expulsa_prio(BCP *nuevo, BCP *actual) {
+    return nuevo->prioridad < actual->prioridad;
+}
+
+static void iniciar_prio(BCP *proc) {
+    proc->prioridad = PRIORIDAD_DEFECTO;
+    proc->ticksRestantes = TICKS_POR_RODAJA;
+}
+
+/*
+ * Rodaja de un nivel MLFQ: TICKS_POR_RODAJA*4^nivel
+ */
+static unsigned int rodaja_mlfq(BCP *proc) {
+    return TICKS_POR_RODAJA << (2 * proc->prioridad);
+}
+
+/*
+ * Sube todos los procesos al nivel 0 de MLFQ para evitar inanicion de
+ * los que han caido a los niveles inferiores
+ */
+static void impulsar_mlfq() {
+    BCP *proc;
+    int i;
+
+    for (i = 0; i < num_bloques_procs * PROCS_POR_BLOQUE; i++) {
+        proc = entrada_tabla_proc(i);
+        if (proc->estado != NO_USADA && !proc->tiempo_real) {
+            proc->prioridad = 0;
+            proc->ticksRestantes = rodaja_mlfq(proc);
+        }
+    }
+
+    for (i = 1; i < NIVELES_MLFQ; i++)
+        concatenar_lista(&colas_listos[0], &colas_listos[i]);
+    if (colas_listos[0].primero != NULL)
+        mapa_listos = 1U;
+}
+
+static void tick_mlfq(BCP *proc, unsigned int ticks) {
+    consumir_rodaja(proc, ticks);
+    if ((ticks_desde_boost += ticks) >= PERIODO_BOOST_MLFQ) {
+        ticks_desde_boost = 0;
+        impulsar_mlfq();
+    }
+}
+
+static int ceder_mlfq(BCP *proc, int agotada) {
+    int nivel_listo;
+
+    /* agotar la rodaja baja de nivel; bloquearse antes no */
+    if (agotada) {
+        if (proc->prioridad < NIVELES_MLFQ - 1)
+            proc->prioridad++;
+        proc->ticksRestantes = rodaja_mlfq(proc);
+    }
+    nivel_listo = nivel_max_listo();
+    if (nivel_listo == -1 || nivel_listo > proc->prioridad)
+        return 0;
+    return nivel_listo < proc->prioridad || agotada;
+}
+
+static void iniciar_mlfq(BCP *proc) {
+    proc->prioridad = 0;
+    proc->ticksRestantes = rodaja_mlfq(proc);
+}
+
+/*
+ * Clase equitativa (CFS): los listos estan en un monticulo ordenado por el
+ * tiempo virtual consumido, que avanza en cada tick ponderado por el peso
+ * del proceso. La rodaja reparte LATENCIA_CFS entre los ejecutables sin
+ * bajar de GRANULARIDAD_CFS.
+ */
+
+/*
+ * Peso de un proceso en CFS: proporcional a su prioridad, de forma que
+ * con PRIORIDAD_DEFECTO el tiempo virtual avanza igual que el real
+ */
+static unsigned int peso_proceso(BCP *proc) {
+    return NUM_PRIORIDADES - proc->prioridad;
+}
+
+static unsigned int rodaja_cfs() {
+    unsigned int ejecutables = monticulo_listos.num + 1;
+
+    if (LATENCIA_CFS / ejecutables < GRANULARIDAD_CFS)
+        return GRANULARIDAD_CFS;
+    return LATENCIA_CFS / ejecutables;
+}
+
+static void encolar_cfs(BCP *proc) {
+    /* un proceso que vuelve de un bloqueo no puede acumular mas
+       ventaja que media latencia respecto al resto */
+    if (tiempo_virtual_min > LATENCIA_CFS * TIEMPO_VIRTUAL_TICK / 2 &&
+        proc->tiempo_virtual <
+        tiempo_virtual_min - LATENCIA_CFS * TIEMPO_VIRTUAL_TICK / 2)
+        proc->tiempo_virtual =
+                tiempo_virtual_min - LATENCIA_CFS * TIEMPO_VIRTUAL_TICK / 2;
+    proc->clave_monticulo = proc->tiempo_virtual;
+    insertar_monticulo(&monticulo_listos, proc);
+}
+
+static void desencolar_monticulo(BCP *proc) {
+    eliminar_monticulo(&monticulo_listos, proc);
+}
+
+static BCP *elegir_monticulo() {
+    return cima_monticulo(&monticulo_listos);
+}
+
+/*
+ * Suma al tiempo virtual del proceso los ticks consumidos ponderados por
+ * su peso y actualiza el minimo tiempo virtual del sistema. La rodaja se
+ * recorta si desde que se asigno han aparecido mas ejecutables, y se pide
+ * una int. SW si el primero de los listos ya le lleva mas de
+ * GRANULARIDAD_CFS de ventaja, como comprueba ceder_cfs.
+ */
+static void tick_cfs(BCP *proc, unsigned int ticks) {
+    BCP *cima = cima_monticulo(&monticulo_listos);
+    unsigned long long minimo = proc->tiempo_virtual;
+    unsigned int rodaja = rodaja_cfs();
+
+    proc->tiempo_virtual += (unsigned long long) ticks * TIEMPO_VIRTUAL_TICK *
+                            (NUM_PRIORIDADES - PRIORIDAD_DEFECTO) /
+                            peso_proceso(proc);
+
+    if (cima != NULL && cima->tiempo_virtual < minimo)
+        minimo = cima->tiempo_virtual;
+    if (minimo > tiempo_virtual_min)
+        tiempo_virtual_min = minimo;
+    if (proc->ticksRestantes > rodaja)
+        proc->ticksRestantes = rodaja;
+    consumir_rodaja(proc, ticks);
+    if (cima != NULL && cima->tiempo_virtual +
+        GRANULARIDAD_CFS * TIEMPO_VIRTUAL_TICK < proc->tiempo_virtual)
+        activar_int_SW();
+}
+
+static int ceder_cfs(BCP *proc, int agotada) {
+    BCP *cima = cima_monticulo(&monticulo_listos);
+
+    if (agotada)
+        proc->ticksRestantes = rodaja_cfs();
+    if (cima == NULL)
+        return 0;
+    if (agotada)
+        return cima->tiempo_virtual < proc->tiempo_virtual;
+    return cima->tiempo_virtual + GRANULARIDAD_CFS * TIEMPO_VIRTUAL_TICK <
+           proc->tiempo_virtual;
+}
+
+static int expulsa_cfs(BCP *nuevo, BCP *actual) {
+    return nuevo->tiempo_virtual + GRANULARIDAD_CFS * TIEMPO_VIRTUAL_TICK <
+           actual->tiempo_virtual;
+}
+
+static void iniciar_cfs(BCP *proc) {
+    proc->prioridad = PRIORIDAD_DEFECTO;
+    proc->tiempo_virtual = tiempo_virtual_min;
+    proc->ticksRestantes = rodaja_cfs();
+}
+
+/*
+ * Clase de zancadas (stride): los listos estan en el mismo monticulo
+ * ordenado por su pase, que avanza la zancada del proceso en cada tick.
+ * Solo se reparte la UCP al final de cada RODAJA_STRIDE.
+ */
+static void encolar_stride(BCP *proc) {
+    /* al volver de un bloqueo no conserva el pase atrasado */
+    if (proc->pase < pase_global)
+        proc->pase = pase_global;
+    proc->clave_monticulo = proc->pase;
+    insertar_monticulo(&monticulo_listos, proc);
+}
+
+/*
+ * Suma al pase del proceso su zancada por cada tick consumido y actualiza
+ * el pase global, que solo puede crecer
+ */
+static void tick_stride(BCP *proc, unsigned int ticks) {
+    BCP *cima = cima_monticulo(&monticulo_listos);
+    unsigned long long minimo = proc->pase;
+
+    proc->pase += (unsigned long long) ticks * proc->zancada;
+
+    if (cima != NULL && cima->pase < minimo)
+        minimo = cima->pase;
+    if (minimo > pase_global)
+        pase_global = minimo;
+    consumir_rodaja(proc, ticks);
+}
+
+static int ceder_stride(BCP *proc, int agotada) {
+    BCP *cima = cima_monticulo(&monticulo_listos);
+
+    if (agotada)
+        proc->ticksRestantes = RODAJA_STRIDE;
+    proc->clave_monticulo = proc->pase;
+    return agotada && cima != NULL && precede_monticulo(cima, proc);
+}
+
+static void iniciar_stride(BCP *proc) {
+    proc->prioridad = PRIORIDAD_DEFECTO;
+    proc->pase = pase_global + proc->zancada;
+    proc->ticksRestantes = RODAJA_STRIDE;
+}
+
+/*
+ * Clase de tiempo real (EDF): monticulo ordenado por plazo. En cada tick
+ * descuenta el presupuesto del periodo. Si sigue trabajando al llegar su
+ * plazo cuenta un fallo y pasa al siguiente periodo; si agota el
+ * presupuesto cuenta un exceso y pide una int. SW para que se le retire
+ * la UCP hasta su siguiente activacion.
+ */
+static void encolar_tiempo_real(BCP *proc) {
+    proc->clave_monticulo = proc->plazo;
+    insertar_monticulo(&monticulo_tiempo_real, proc);
+}
+
+static void desencolar_tiempo_real(BCP *proc) {
+    eliminar_monticulo(&monticulo_tiempo_real, proc);
+}
+
+static BCP *elegir_tiempo_real() {
+    return cima_monticulo(&monticulo_tiempo_real);
+}
+
+static void tick_tiempo_real(BCP *proc, unsigned int ticks) {
+    if (ticks_sistema >= proc->plazo) {
+        proc->fallos_plazo++;
+        while (proc->plazo <= ticks_sistema)
+            proc->plazo += proc->periodo;
+        proc->presupuesto_restante = proc->presupuesto;
+    }
+    if (proc->presupuesto_restante > ticks)
+        proc->presupuesto_restante -= ticks;
+    else
+        proc->presupuesto_restante = 0;
+    if (proc->presupuesto_restante == 0) {
+        if (!proc->estrangulado)
+            proc->excesos_presupuesto++;
+        proc->estrangulado = 1;
+        activar_int_SW();
+    }
+}
+
+static int ceder_tiempo_real(BCP *proc, int agotada) {
+    BCP *cima = cima_monticulo(&monticulo_tiempo_real);
+
+    proc->clave_monticulo = proc->plazo;
+    return cima != NULL && precede_monticulo(cima, proc);
+}
+
+static int expulsa_tiempo_real(BCP *nuevo, BCP *actual) {
+    return nuevo->plazo < actual->plazo;
+}
+
+/*
+ * Tabla de clases de planificacion seleccionables en el arranque,
+ * indexada por las constantes PLANIF_*
+ */
+static clase_planif clases_planif[NUM_POLITICAS] = {
+        {"prioridades", encolar_prio, desencolar_prio, elegir_prio,
+                tick_prio, ceder_prio, expulsa_prio, iniciar_prio, 1,
+                encolar_lote_prio},
+        {"mlfq", encolar_prio, desencolar_prio, elegir_prio,
+                tick_mlfq, ceder_mlfq, expulsa_prio, iniciar_mlfq, 0,
+                encolar_lote_prio},
+        {"cfs", encolar_cfs, desencolar_monticulo, elegir_monticulo,
+                tick_cfs, ceder_cfs, expulsa_cfs, iniciar_cfs, 0},
+        {"stride", encolar_stride, desencolar_monticulo, elegir_monticulo,
+                tick_stride, ceder_stride, expulsa_fifo, iniciar_stride, 0},
+        {"fifo", encolar_fifo, desencolar_fifo, elegir_fifo,
+                tick_fifo, ceder_fifo, expulsa_fifo, iniciar_fifo, 1,
+                encolar_lote_fifo},
+        {"rr", encolar_fifo, desencolar_fifo, elegir_fifo,
+                tick_rr, ceder_rr, expulsa_fifo, iniciar_fifo, 1,
+                encolar_lote_fifo}};
+
+/*
+ * Clase de tiempo real, que tiene precedencia sobre la clase normal
+ */
+static clase_planif clase_tiempo_real = {
+        "tiempo real", encolar_tiempo_real, desencolar_tiempo_real,
+        elegir_tiempo_real, tick_tiempo_real, ceder_tiempo_real,
+        expulsa_tiempo_real, iniciar_fifo, 0};
+
+/*
+ *
+ * Funciones que manejan el conjunto de procesos listos a traves de las
+ * clases de planificacion
+ *	clase_de insertar_listo insertar_listos_nuevos eliminar_listo
+ *	hay_listos comprobar_expulsion
+ *	programar_tick ticks_hasta_despertar ajustar_tick
+ *	seleccionar_planificador
+ */
+
+/*
+ * Devuelve la clase de planificacion de un proceso
+ */
+static clase_planif *clase_de(BCP *proc) {
+    if (proc->tiempo_real)
+        return &clase_tiempo_real;
+    return clase_normal;
+}
+
+/*
+ * Publica en la pagina del sistema los ticks y la hora actuales
+ */
+static void publicar_reloj() {
+    pagina_nucleo->secuencia++;
+    pagina_nucleo->ticks = ticks_sistema;
+    pagina_nucleo->hora = leer_reloj_CMOS();
+    pagina_nucleo->secuencia++;
+}
+
+/*
+ * Publica en la pagina del sistema el proceso que pasa a ejecutar y sus
+ * avisos de temporizador pendientes
+ */
+static void publicar_proceso(BCP *proc) {
+    pagina_nucleo->id_actual = proc->id;
+    pagina_nucleo->avisos = proc->avisos_pendientes;
+}
+
+/*
+ * Programa el reloj para que interrumpa cada "ticks" ticks. Si se corta
+ * un periodo largo del tick dinamico, antes suma a ticks_sistema los
+ * ticks completos que ya han pasado, para que el tiempo no se retrase.
+ */
+static void programar_tick(unsigned int ticks) {
+    struct itimerval restante;
+    long long transcurrido;
+
+    if (ticks_por_int > 1 && getitimer(ITIMER_REAL, &restante) == 0) {
+        transcurrido = (long long) ticks_por_int * (1000000 / TICK) -
+                       (restante.it_value.tv_sec * 1000000LL +
+                        restante.it_value.tv_usec);
+        if (transcurrido > 0) {
+            ticks_sistema += transcurrido / (1000000 / TICK);
+            if (p_proc_actual == &bcp_ocioso)
+                ticks_ociosos += transcurrido / (1000000 / TICK);
+            publicar_reloj();
+        }
+    }
+    ticks_por_int = ticks;
+    iniciar_cont_reloj(TICK / ticks);
+}
+
+/*
+ * Devuelve verdadero si el proceso pertenece a un grupo que ha agotado
+ * su cuota de UCP en el periodo actual
+ */
+static int grupo_estrangulado(BCP *proc) {
+    return proc->grupo != -1 && grupos[proc->grupo].estrangulado;
+}
+
+/*
+ * Inserta un proceso en el conjunto de listos de su clase o, si su grupo
+ * esta estrangulado, en la lista de espera del grupo
+ */
+static void insertar_listo(BCP *proc) {
+    if (grupo_estrangulado(proc)) {
+        insertar_ultimo(&grupos[proc->grupo].estrangulados, proc);
+        return;
+    }
+    /* con un nuevo ejecutable vuelve a hacer falta el tick completo */
+    if (ticks_por_int != 1)
+        programar_tick(1);
+    clase_de(proc)->encolar(proc);
+}
+
+/*
+ * Inserta en listos un lote de procesos recien creados, todos de la clase
+ * normal y del grupo del proceso actual, empalmando la lista entera si la
+ * clase lo permite
+ */
+static void insertar_listos_nuevos(lista_BCPs *lote) {
+    BCP *proc;
+
+    if (grupo_estrangulado(lote->primero)) {
+        concatenar_lista(&grupos[lote->primero->grupo].estrangulados, lote);
+        return;
+    }
+    if (ticks_por_int != 1)
+        programar_tick(1);
+    if (clase_normal->encolar_lote != NULL) {
+        clase_normal->encolar_lote(lote);
+        return;
+    }
+    while ((proc = lote->primero) != NULL) {
+        eliminar_primero(lote);
+        clase_normal->encolar(proc);
+    }
+}
+
+/*
+ * Elimina un proceso del conjunto de listos de su clase
+ */
+static void eliminar_listo(BCP *proc) {
+    if (grupo_estrangulado(proc))
+        eliminar_elem(&grupos[proc->grupo].estrangulados, proc);
+    else
+        clase_de(proc)->desencolar(proc);
+}
+
+/*
+ * Devuelve verdadero si hay algun proceso listo
+ */
+static int hay_listos() {
+    return clase_tiempo_real.elegir_siguiente() != NULL ||
+           clase_normal->elegir_siguiente() != NULL;
+}
+
+/*
+ * Solicita una int. SW si el proceso que acaba de pasar a listo debe
+ * expulsar al que esta en ejecucion: siempre que sea de una clase
+ * superior y, si es de la misma, cuando lo decida la clase.
+ */
+static void comprobar_expulsion(BCP *proc) {
+    if (p_proc_actual == NULL || p_proc_actual->estado != EJECUCION)
+        return;
+    if (clase_de(proc) != clase_de(p_proc_actual)) {
+        if (proc->tiempo_real)
+            activar_int_SW();
+        return;
+    }
+    if (clase_de(proc)->expulsa(proc, p_proc_actual))
+        activar_int_SW();
+}
+
+/*
+ * Devuelve el tick absoluto del siguiente lote de despertares o
+ * vencimiento de temporizador o 0 si no hay ninguno
+ */
+static unsigned long long proximo_despertar() {
+    BCP *proc = cima_monticulo(&monticulo_dormidos);
+
+    if (proc == NULL && lista_temporizadores == NULL)
+        return 0;
+    if (proc == NULL || (lista_temporizadores != NULL &&
+                         lista_temporizadores->vencimiento <
+                         proc->clave_monticulo))
+        return lista_temporizadores->vencimiento;
+    return proc->clave_monticulo;
+}
+
+/*
+ * Devuelve los ticks que faltan para el siguiente lote de despertares o
+ * vencimiento de temporizador (como mucho TICK) o 0 si no hay ninguno
+ */
+static unsigned int ticks_hasta_despertar() {
+    unsigned long long proximo = proximo_despertar();
+
+    if (proximo == 0)
+        return 0;
+    if (proximo <= ticks_sistema)
+        return 1;
+    if (proximo - ticks_sistema > TICK)
+        return TICK;
+    return (unsigned int) (proximo - ticks_sistema);
+}
+
+/*
+ * Devuelve los ticks que faltan para renovar las cuotas de los grupos si
+ * hay alguno estrangulado o 0 si no hay ninguno
+ */
+static unsigned int ticks_hasta_fin_periodo() {
+    int i;
+
+    for (i = 0; i < MAX_GRUPOS; i++)
+        if (grupos[i].estrangulado)
+            return PERIODO_GRUPOS - ticks_periodo_grupos;
+    return 0;
+}
+
+/*
+ * Devuelve verdadero si hay que contabilizar cada tick del proceso en
+ * ejecucion: lo necesita su clase, la cuota de su grupo o sus limites de
+ * tiempo de UCP
+ */
+static int necesita_tick(BCP *proc) {
+    return !clase_de(proc)->tick_prescindible ||
+           (proc->grupo != -1 && grupos[proc->grupo].cuota != 0) ||
+           proc->limite_blando != 0 || proc->limite_duro != 0;
+}
+
+/*
+ * Tick dinamico. Si no hay ningun proceso ejecutable, o solo el actual y
+ * no necesita que se contabilice cada tick, reprograma el
+ * reloj para que no interrumpa hasta el despertar del primer dormido, el
+ * vencimiento del primer temporizador o la renovacion de las cuotas de grupo (como mucho un segundo); int_reloj
+ * avanza entonces el tiempo de golpe. El periodo se redondea a un divisor
+ * de TICK para que la frecuencia programada sea exacta.
+ */
+static void ajustar_tick() {
+    unsigned int ticks = 1, proximo, fin_periodo;
+    int ejecuta = (p_proc_actual != NULL && p_proc_actual->estado == EJECUCION);
+
+    if (tick_dinamico && !hay_listos() &&
+        (!ejecuta || !necesita_tick(p_proc_actual))) {
+        proximo = ticks_hasta_despertar();
+        fin_periodo = ticks_hasta_fin_periodo();
+        if (fin_periodo != 0 && (proximo == 0 || fin_periodo < proximo))
+            proximo = fin_periodo;
+        ticks = (proximo == 0 || proximo > TICK) ? TICK : proximo;
+        while (TICK % ticks != 0)
+            ticks--;
+    }
+    if (ticks != ticks_por_int)
+        programar_tick(ticks);
+}
+
+/*
+ * Selecciona la clase de planificacion normal por su nombre (NULL para la
+ * politica por defecto POLITICA_PLANIF)
+ */
+static void seleccionar_planificador(char *nombre) {
+    int i;
+
+    politica_planif = POLITICA_PLANIF;
+    if (nombre != NULL) {
+        for (i = 0; i < NUM_POLITICAS && strcmp(clases_planif[i].nombre, nombre);
+             i++);
+        if (i < NUM_POLITICAS)
+            politica_planif = i;
+        else
+            printk("-> PLANIFICADOR %s DESCONOCIDO\n", nombre);
+    }
+    clase_normal = &clases_planif[politica_planif];
+    printk("-> PLANIFICADOR: %s\n", clase_normal->nombre);
+}
+
+/*
+ *
+ * Funciones que manejan los grupos de procesos con cuota de UCP
+ *	estrangular_grupo contabilizar_grupo renovar_cuotas_grupos
+ */
+
+/*
+ * Retira del conjunto de listos a los procesos del grupo, que esperan en
+ * la lista del grupo hasta el siguiente periodo
+ */
+static void estrangular_grupo(int grupo) {
+    BCP *proc;
+    int i;
+
+    for (i = 0; i < num_bloques_procs * PROCS_POR_BLOQUE; i++) {
+        proc = entrada_tabla_proc(i);
+        if (proc->estado == LISTO && proc->grupo == grupo) {
+            eliminar_listo(proc);
+            insertar_ultimo(&grupos[grupo].estrangulados, proc);
+        }
+    }
+    grupos[grupo].estrangulado = 1;
+}
+
+/*
+ * Suma los ticks consumidos por el proceso actual a su grupo. Si el grupo
+ * agota la cuota lo estrangula y pide una int. SW para retirar tambien
+ * al proceso actual.
+ */
+static void contabilizar_grupo(BCP *proc, unsigned int ticks) {
+    grupo_procs *grupo = &grupos[proc->grupo];
+
+    grupo->consumido += ticks;
+    grupo->total += ticks;
+    if (grupo->cuota != 0 && grupo->consumido >= grupo->cuota &&
+        !grupo->estrangulado) {
+        estrangular_grupo(proc->grupo);
+        activar_int_SW();
+    }
+}
+
+/*
+ * Empieza un nuevo periodo de contabilidad: pone a cero el consumo de
+ * todos los grupos y devuelve a listos a los procesos estrangulados
+ */
+static void renovar_cuotas_grupos() {
+    int i;
+    BCP *proc;
+
+    ticks_periodo_grupos = 0;
+    for (i = 0; i < MAX_GRUPOS; i++) {
+        grupos[i].consumido = 0;
+        if (!grupos[i].estrangulado)
+            continue;
+        grupos[i].estrangulado = 0;
+        while ((proc = grupos[i].estrangulados.primero) != NULL) {
+            eliminar_primero(&grupos[i].estrangulados);
+            insertar_listo(proc);
+            comprobar_expulsion(proc);
+        }
+    }
+}
+
+/*
+ * Suma los ticks consumidos por el proceso actual a su tiempo de UCP.
+ * Avisa una vez al superar el limite blando y, al alcanzar el duro, pide
+ * una int. SW para que lo termine (se repite en cada tick hasta que se
+ * trate, por si se difiere mientras el proceso esta dentro del nucleo).
+ */
+static void comprobar_limites_ucp(BCP *proc, unsigned int ticks) {
+    proc->tiempo_ucp += ticks;
+    if (proc->limite_blando != 0 && !proc->aviso_limite &&
+        proc->tiempo_ucp >= proc->limite_blando) {
+        proc->aviso_limite = 1;
+        printk("-> PROC %d: LIMITE BLANDO DE UCP SUPERADO (%u TICKS)\n",
+               proc->id, proc->limite_blando);
+    }
+    if (proc->limite_duro != 0 && proc->tiempo_ucp >= proc->limite_duro)
+        activar_int_SW();
+}
+
+/*
+ * Funci�n de planificacion. Extrae el proceso que elige la clase de tiempo
+ * real o, si no tiene listos, el que elige la clase normal. Si no hay
+ * ningun listo devuelve la tarea ociosa.
+ */
+static BCP *planificador() {
+    BCP *proc;
+
+    if (!hay_listos()) {
+        publicar_proceso(&bcp_ocioso);
+        return &bcp_ocioso;
+    }
+
+    proc = clase_tiempo_real.elegir_siguiente();
+    if (proc == NULL)
+        proc = clase_normal->elegir_siguiente();
+    eliminar_listo(proc);
+    proc->estado = EJECUCION;
+    publicar_proceso(proc);
+    return proc;
+}
+
+/*
+ *
+ * Funciones que manejan los procesos dormidos
+ *	insertar_dormido despertar_dormidos
+ */
+
+/*
+ * Pone al dia ticks_sistema si el tick dinamico ha alargado el periodo
+ * del reloj, volviendo al tick completo
+ */
+static void sincronizar_reloj() {
+    int nivel = fijar_nivel_int(NIVEL_3);
+
+    if (ticks_por_int != 1)
+        programar_tick(1);
+    fijar_nivel_int(nivel);
+}
+
+/*
+ * Duerme un proceso, ya BLOQUEADO, hasta el tick absoluto indicado. Su
+ * despertar se puede retrasar hasta "holgura" ticks para agruparlo con
+ * otros; los de tiempo real no tienen holgura. El monticulo se ordena por
+ * el ultimo tick admisible de despertar.
+ */
+static void insertar_dormido(BCP *proc, unsigned long long tick) {
+    proc->despertar = tick;
+    proc->clave_monticulo = tick;
+    if (!proc->tiempo_real)
+        proc->clave_monticulo += proc->holgura;
+    insertar_monticulo(&monticulo_dormidos, proc);
+}
+
+/*
+ * Cuando llega el ultimo tick admisible del primer dormido, pasa a listos
+ * en un mismo lote a ese y a los siguientes de la cima del monticulo
+ * mientras su tick de despertar haya llegado, aunque aun les quede
+ * holgura. Un tick sin despertares solo mira la cima y uno con k
+ * despertares cuesta O(k log n).
+ */
+static void despertar_dormidos() {
+    /* el lote se encadena por el campo siguiente, libre en los dormidos */
+    lista_BCPs lote = {NULL, NULL};
+    BCP *proc;
+
+    proc = cima_monticulo(&monticulo_dormidos);
+    if (proc == NULL || proc->clave_monticulo > ticks_sistema)
+        return;
+
+    while (proc != NULL && proc->despertar <= ticks_sistema) {
+        eliminar_monticulo(&monticulo_dormidos, proc);
+        insertar_ultimo(&lote, proc);
+        proc = cima_monticulo(&monticulo_dormidos);
+    }
+    while ((proc = lote.primero) != NULL) {
+        eliminar_primero(&lote);
+        proc->estado = LISTO;
+        insertar_listo(proc);
+        comprobar_expulsion(proc);
+    }
+}
+
+/*
  *
+ * Funciones que manejan los temporizadores
+ *	armar_temporizador desarmar_temporizador vencer_temporizadores
+ *	liberar_temporizadores
  */
 
 /*
- * Funci�n que inicia la tabla de procesos
+ * Arma un temporizador para que venza en el tick absoluto indicado,
+ * insertandolo en orden en la lista de armados detras de los que vencen
+ * en el mismo tick
  */
-static void iniciar_tabla_proc() {
-    int i;
+static void armar_temporizador(temporizador *temp, unsigned long long tick) {
+    temporizadorptr *pos = &lista_temporizadores;
+
+    while (*pos != NULL && (*pos)->vencimiento <= tick)
+        pos = &(*pos)->siguiente;
+    temp->vencimiento = tick;
+    temp->siguiente = *pos;
+    *pos = temp;
+}
 
-    for (i = 0; i < MAX_PROC; i++)
-        tabla_procs[i].estado = NO_USADA;
+/*
+ * Saca un temporizador de la lista de armados, si lo esta
+ */
+static void desarmar_temporizador(temporizador *temp) {
+    temporizadorptr *pos = &lista_temporizadores;
+
+    if (temp->vencimiento == 0)
+        return;
+    while (*pos != temp)
+        pos = &(*pos)->siguiente;
+    *pos = temp->siguiente;
+    temp->vencimiento = 0;
+}
+
+/*
+ * Trata los temporizadores vencidos en el mismo camino del reloj que los
+ * dormidos: un tick sin vencimientos solo mira el primero de la lista. Los
+ * periodicos se rearman desde su vencimiento anterior, de modo que no
+ * acumulan deriva y, si el tick dinamico ha saltado varios periodos,
+ * cuentan todos los vencimientos.
+ */
+static void vencer_temporizadores() {
+    temporizador *temp;
+    BCP *proc;
+
+    while ((temp = lista_temporizadores) != NULL &&
+           temp->vencimiento <= ticks_sistema) {
+        lista_temporizadores = temp->siguiente;
+        proc = temp->proceso;
+        temp->vencimientos++;
+        if (temp->funcion != NULL) {
+            proc->avisos_pendientes++;
+            if (proc == p_proc_actual)
+                publicar_proceso(proc);
+        } else if (temp->esperando) {
+            temp->esperando = 0;
+            proc->estado = LISTO;
+            insertar_listo(proc);
+            comprobar_expulsion(proc);
+        }
+        if (temp->periodo != 0)
+            armar_temporizador(temp, temp->vencimiento + temp->periodo);
+        else
+            temp->vencimiento = 0;
+    }
 }
 
 /*
- * Funci�n que busca una entrada libre en la tabla de procesos
+ * Destruye los temporizadores de un proceso que termina
  */
-static int buscar_BCP_libre() {
+static void liberar_temporizadores(BCP *proc) {
     int i;
 
-    for (i = 0; i < MAX_PROC; i++)
-        if (tabla_procs[i].estado == NO_USADA)
-            return i;
-    return -1;
+    for (i = 0; i < MAX_TEMPORIZADORES; i++)
+        if (temporizadores[i].usado && temporizadores[i].proceso == proc) {
+            desarmar_temporizador(&temporizadores[i]);
+            temporizadores[i].usado = 0;
+        }
+    proc->avisos_pendientes = 0;
 }
 
 /*
  *
- * Funciones que facilitan el manejo de las listas de BCPs
- *	insertar_ultimo eliminar_primero eliminar_elem
+ * Funciones que hacen avanzar el reloj del sistema
+ *	avanzar_reloj saltar_reloj
+ */
+
+/*
+ * Hace avanzar el reloj los ticks indicados y trata lo que depende de el:
+ * despertares, vencimientos, contabilidad del proceso actual y cuotas de
+ * grupo. La usan la interrupcion de reloj y el tiempo virtual.
+ */
+static void avanzar_reloj(unsigned int transcurridos) {
+    ticks_sistema += transcurridos;
+    if (p_proc_actual == &bcp_ocioso)
+        ticks_ociosos += transcurridos;
+    publicar_reloj();
+    // Tratar procesos dormidos y temporizadores vencidos
+    despertar_dormidos();
+    vencer_temporizadores();
+
+
+    // Contabilizar el tick en la clase del proceso actual (rodajas,
+    // tiempo virtual, presupuesto de tiempo real...)
+    if (p_proc_actual->estado == EJECUCION)
+        clase_de(p_proc_actual)->tick(p_proc_actual, transcurridos);
+
+    // Comprobar los limites de tiempo de UCP del proceso actual
+    if (p_proc_actual->estado == EJECUCION)
+        comprobar_limites_ucp(p_proc_actual, transcurridos);
+
+    // Contabilizar el tick en la cuota del grupo del proceso actual
+    if (p_proc_actual->estado == EJECUCION && p_proc_actual->grupo != -1)
+        contabilizar_grupo(p_proc_actual, transcurridos);
+    if ((ticks_periodo_grupos += transcurridos) >= PERIODO_GRUPOS)
+        renovar_cuotas_grupos();
+}
+
+/*
+ * Tiempo virtual. Con todos los procesos bloqueados, salta el reloj hasta
+ * el siguiente despertar, vencimiento de temporizador o renovacion de
+ * cuotas de grupo en vez de esperar a que pase ese tiempo real. Como se
+ * salta exactamente a ese tick, los procesos despiertan en el mismo orden
+ * que con el reloj real. Devuelve 0 si no hay nada que esperar con el
+ * reloj.
+ */
+static int saltar_reloj() {
+    unsigned long long proximo = proximo_despertar();
+    unsigned int fin_periodo = ticks_hasta_fin_periodo();
+
+    if (fin_periodo != 0 &&
+        (proximo == 0 || ticks_sistema + fin_periodo < proximo))
+        proximo = ticks_sistema + fin_periodo;
+    if (proximo == 0)
+        return 0;
+
+    /* el reloj real no debe sumar despues un periodo largo ya saltado */
+    if (ticks_por_int != 1)
+        programar_tick(1);
+    if (proximo <= ticks_sistema)
+        avanzar_reloj(1);
+    else
+        avanzar_reloj((unsigned int) (proximo - ticks_sistema));
+    return 1;
+}
+
+/*
  *
- * NOTA: PRIMERO SE DEBE LLAMAR A eliminar Y LUEGO A insertar
+ * Funciones que manejan la cache de imagenes de programas
+ *	cargar_imagen retener_imagen soltar_imagen
  */
 
 /*
- * Inserta un BCP al final de la lista.
+ * Devuelve la imagen del programa indicado para "procesos" procesos
+ * nuevos. Si ya esta cargada para otro proceso se comparte (solo se crean
+ * de nuevo la pila y el BCP) y, si no, se carga con crear_imagen y se
+ * anade a la cache con una referencia por proceso. Si el nombre es
+ * demasiado largo se anade sin nombre, para que no se vuelva a repartir.
+ * Si la cache esta llena la imagen queda fuera de ella y solo puede ser
+ * de un proceso, de modo que con varios no se carga y se devuelve NULL.
  */
-static void insertar_ultimo(lista_BCPs *lista, BCP *proc) {
-    if (lista->primero == NULL)
-        lista->primero = proc;
+static void *cargar_imagen(char *prog, void **pc_inicial,
+                           unsigned int procesos) {
+    int i, libre = -1;
+    void *imagen;
+
+    for (i = 0; i < MAX_IMAGENES; i++)
+        if (cache_imagenes[i].referencias == 0) {
+            if (libre == -1)
+                libre = i;
+        } else if (cache_imagenes[i].nombre[0] != '\0' &&
+                   strcmp(cache_imagenes[i].nombre, prog) == 0) {
+            cache_imagenes[i].referencias += procesos;
+            aciertos_imagenes += procesos;
+            *pc_inicial = cache_imagenes[i].pc_inicial;
+            return cache_imagenes[i].imagen;
+        }
+
+    if (libre == -1 && procesos > 1)
+        return NULL;
+    fallos_imagenes++;
+    imagen = crear_imagen(prog, pc_inicial);
+    if (imagen == NULL || libre == -1)
+        return imagen;
+    if (strlen(prog) >= MAX_NOM_PROG)
+        cache_imagenes[libre].nombre[0] = '\0';
     else
-        lista->ultimo->siguiente = proc;
-    lista->ultimo = proc;
-    proc->siguiente = NULL;
+        strcpy(cache_imagenes[libre].nombre, prog);
+    cache_imagenes[libre].imagen = imagen;
+    cache_imagenes[libre].pc_inicial = *pc_inicial;
+    cache_imagenes[libre].referencias = procesos;
+    aciertos_imagenes += procesos - 1;
+    return imagen;
 }
 
 /*
- * Elimina el primer BCP de la lista.
+ * Anade la referencia de un hilo nuevo a la imagen del proceso que lo
+ * crea. Si la imagen no esta en la cache se anota en ella sin nombre, para
+ * que cargar_imagen no la reparta, con la referencia del proceso y la del
+ * hilo. Devuelve -1 si la cache esta llena.
  */
-static void eliminar_primero(lista_BCPs *lista) {
+static int retener_imagen(void *imagen) {
+    int i, libre = -1;
+
+    for (i = 0; i < MAX_IMAGENES; i++)
+        if (cache_imagenes[i].referencias == 0) {
+            if (libre == -1)
+                libre = i;
+        } else if (cache_imagenes[i].imagen == imagen) {
+            cache_imagenes[i].referencias++;
+            return 0;
+        }
 
-    if (lista->ultimo == lista->primero)
-        lista->ultimo = NULL;
-    lista->primero = lista->primero->siguiente;
+    if (libre == -1)
+        return -1;
+    cache_imagenes[libre].nombre[0] = '\0';
+    cache_imagenes[libre].imagen = imagen;
+    cache_imagenes[libre].pc_inicial = NULL;
+    cache_imagenes[libre].referencias = 2;
+    return 0;
 }
 
 /*
- * Elimina un determinado BCP de la lista.
+ * Suelta la referencia de un proceso o hilo terminado a su imagen, que se
+ * libera cuando no la usa ninguno
  */
-static void eliminar_elem(lista_BCPs *lista, BCP *proc) {
-    BCP *paux = lista->primero;
+static void soltar_imagen(void *imagen) {
+    int i;
 
-    if (paux == proc)
-        eliminar_primero(lista);
-    else {
-        for (; ((paux) && (paux->siguiente != proc));
-               paux = paux->siguiente);
-        if (paux) {
-            if (lista->ultimo == paux->siguiente)
-                lista->ultimo = paux;
-            paux->siguiente = paux->siguiente->siguiente;
+    for (i = 0; i < MAX_IMAGENES; i++)
+        if (cache_imagenes[i].referencias > 0 &&
+            cache_imagenes[i].imagen == imagen) {
+            if (--cache_imagenes[i].referencias > 0)
+                return;
+            break;
         }
-    }
+    liberar_imagen(imagen);
 }
 
 /*
  *
- * Funciones relacionadas con la planificacion
- *	espera_int planificador
+ * Funciones que manejan la reserva de pilas y BCPs preparados para crear
+ * procesos sin reservar memoria
+ *	obtener_pila devolver_pila reponer_pila iniciar_reserva
  */
 
 /*
- * Espera a que se produzca una interrupcion
+ * Devuelve una pila de la reserva o, si esta vacia, una nueva
  */
-static void espera_int() {
+static void *obtener_pila() {
+    if (num_pilas_libres > 0)
+        return pilas_libres[--num_pilas_libres];
+    return crear_pila(TAM_PILA);
+}
+
+/*
+ * Guarda en la reserva la pila de un proceso terminado o, si ya esta
+ * llena, la libera
+ */
+static void devolver_pila(void *pila) {
+    if (num_pilas_libres < reserva_procesos)
+        pilas_libres[num_pilas_libres++] = pila;
+    else
+        liberar_pila(pila);
+}
+
+/*
+ * Anade una pila nueva a la reserva. La usa la tarea ociosa para
+ * rellenarla sin retrasar a los procesos.
+ */
+static void reponer_pila() {
+    pilas_libres[num_pilas_libres++] = crear_pila(TAM_PILA);
+}
+
+/*
+ * Prepara en el arranque la reserva de reserva_procesos pilas y entradas
+ * de la tabla de procesos
+ */
+static void iniciar_reserva() {
+    if (reserva_procesos > MAX_PROC)
+        reserva_procesos = MAX_PROC;
+    while (num_bloques_procs * PROCS_POR_BLOQUE < reserva_procesos &&
+           ampliar_tabla_proc() == 0)
+        ;
+    while (num_pilas_libres < reserva_procesos)
+        reponer_pila();
+}
+
+/*
+ *
+ * Funciones de la tarea ociosa
+ *	recoger_proceso recoger_terminados obtener_BCP obtener_BCPs
+ *	tarea_ociosa crear_tarea_ociosa
+ */
+
+/*
+ * Recolector: libera los recursos de un proceso terminado de la cola de
+ * recogida. Devuelve su parte de la utilizacion de tiempo real, deja
+ * huerfanos a sus hijos, suelta su imagen y devuelve su pila a la reserva
+ * (que no se podia tocar hasta el cambio de contexto final). Si nadie va a
+ * recoger su estado libera tambien el BCP.
+ */
+static void recoger_proceso(BCP *proc) {
+    if (proc->tiempo_real) {
+        utilizacion_tiempo_real -= proc->utilizacion;
+        proc->tiempo_real = 0;
+        printk("-> PROC %d: %u FALLOS DE PLAZO, %u EXCESOS DE PRESUPUESTO\n",
+               proc->id, proc->fallos_plazo, proc->excesos_presupuesto);
+    }
+
+    abandonar_hijos(proc);
+    devolver_pila(proc->pila);
+    soltar_imagen(proc->info_mem);
+
+    proc->por_recoger = 0;
+    if (proc->padre == NULL)
+        liberar_BCP(proc);
+}
+
+/*
+ * Recoge como mucho "max" procesos terminados, en orden de terminacion
+ */
+static void recoger_terminados(unsigned int max) {
+    BCP *proc;
     int nivel;
 
-    printk("-> NO HAY LISTOS. ESPERA INT\n");
+    while (max-- > 0) {
+        nivel = fijar_nivel_int(NIVEL_3);
+        proc = lista_por_recoger.primero;
+        if (proc != NULL)
+            eliminar_primero(&lista_por_recoger);
+        fijar_nivel_int(nivel);
+        if (proc == NULL)
+            return;
+        recoger_proceso(proc);
+    }
+}
 
-    /* Baja al m�nimo el nivel de interrupci�n mientras espera */
-    nivel = fijar_nivel_int(NIVEL_1);
-    halt();
-    fijar_nivel_int(nivel);
+/*
+ * Toma un BCP libre para un proceso nuevo. Si la tabla esta llena recoge
+ * antes todos los terminados pendientes, ya que el recolector solo libera
+ * unos pocos en cada tick y sus BCPs pueden ser los unicos disponibles.
+ */
+static BCP *obtener_BCP() {
+    BCP *proc = buscar_BCP_libre();
+
+    if (proc == NULL && lista_por_recoger.primero != NULL) {
+        recoger_terminados(MAX_PROC);
+        proc = buscar_BCP_libre();
+    }
+    return proc;
 }
 
 /*
- * Funci�n de planificacion que implementa un algoritmo FIFO.
+ * Igual que obtener_BCP para un lote de n BCPs (ver reservar_BCPs)
  */
-static BCP *planificador() {
-    while (lista_listos.primero == NULL)
-        espera_int();        /* No hay nada que hacer */
-    return lista_listos.primero;
+static int obtener_BCPs(unsigned int n, lista_BCPs *lote) {
+    if (reservar_BCPs(n, lote) == 0)
+        return 0;
+    if (lista_por_recoger.primero == NULL)
+        return -1;
+    recoger_terminados(MAX_PROC);
+    return reservar_BCPs(n, lote);
+}
+
+/*
+ * Codigo de la tarea ociosa. Cuando hay listos cede la UCP al que elija el
+ * planificador; si no, hace trabajo de mantenimiento pendiente: recoger
+ * procesos terminados, rellenar la reserva de pilas y compactar la tabla
+ * de procesos devolviendo los bloques que quedan libres al final. Cada
+ * unidad de trabajo (un proceso, una pila, un bloque) se hace con las
+ * interrupciones inhibidas y entre una y otra se baja a NIVEL_1 para
+ * atenderlas y comprobar enseguida si alguno ha pasado a listo. Cuando no
+ * queda nada que hacer, para la UCP hasta la siguiente interrupcion o, con
+ * tiempo virtual, salta el reloj al siguiente despertar. El tiempo que
+ * pasa aqui lo contabiliza int_reloj en ticks_ociosos.
+ */
+static void tarea_ociosa() {
+    for (;;) {
+        fijar_nivel_int(NIVEL_3);
+        if (hay_listos()) {
+            p_proc_actual = planificador();
+            printk("-> C.CONTEXTO DESDE OCIOSO: a %d\n", p_proc_actual->id);
+            cambio_contexto(&(bcp_ocioso.contexto_regs),
+                            &(p_proc_actual->contexto_regs));
+        } else if (lista_por_recoger.primero != NULL)
+            recoger_terminados(1);
+        else if (num_pilas_libres < reserva_procesos)
+            reponer_pila();
+        else if (sobra_bloque_procs())
+            reducir_tabla_proc();
+        else if (!tiempo_virtual || !saltar_reloj()) {
+            ajustar_tick();
+            espera_int();        /* No hay nada que hacer */
+        }
+        fijar_nivel_int(NIVEL_1);
+    }
+}
+
+/*
+ * Crea el contexto de la tarea ociosa, que arranca en tarea_ociosa con
+ * una pila propia
+ */
+static void crear_tarea_ociosa() {
+    ucontext_t *ctxt = &(bcp_ocioso.contexto_regs.ctxt);
+
+    bcp_ocioso.id = -1;
+    bcp_ocioso.estado = BLOQUEADO;
+    bcp_ocioso.grupo = -1;
+    bcp_ocioso.pos_monticulo = -1;
+    bcp_ocioso.pila = crear_pila(TAM_PILA);
+
+    getcontext(ctxt);
+    ctxt->uc_stack.ss_sp = bcp_ocioso.pila;
+    ctxt->uc_stack.ss_size = TAM_PILA;
+    ctxt->uc_link = NULL;
+    makecontext(ctxt, tarea_ociosa, 0);
 }
 
 /*
  *
- * Funcion auxiliar que termina proceso actual liberando sus recursos.
- * Usada por llamada terminar_proceso y por rutinas que tratan excepciones
+ * Funciones que manejan la pagina del sistema
+ *	crear_pagina_sistema mapear_pagina_sistema
+ */
+
+/*
+ * Crea la pagina del sistema con dos proyecciones del mismo fichero
+ * temporal: una escribible para el nucleo y otra de solo lectura para
+ * los procesos
+ */
+static void crear_pagina_sistema() {
+    FILE *fich = tmpfile();
+    long tam = sysconf(_SC_PAGESIZE);
+
+    if (fich == NULL || ftruncate(fileno(fich), tam) < 0)
+        panico("no se puede crear la pagina del sistema");
+    pagina_nucleo = mmap(NULL, tam, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         fileno(fich), 0);
+    pagina_usuario = mmap(NULL, tam, PROT_READ, MAP_SHARED, fileno(fich), 0);
+    if (pagina_nucleo == MAP_FAILED || pagina_usuario == MAP_FAILED)
+        panico("no se puede proyectar la pagina del sistema");
+    fclose(fich);
+
+    pagina_nucleo->id_actual = -1;
+    publicar_reloj();
+}
+
+/*
+ * Da a conocer la pagina del sistema a la biblioteca de usuario de una
+ * imagen recien creada, fijando su variable pagina_sistema. Las imagenes
+ * sin biblioteca simplemente no la usan.
+ */
+static void mapear_pagina_sistema(void *imagen) {
+    pagina_sistema_t **dir = dlsym(imagen, "pagina_sistema");
+
+    if (dir != NULL)
+        *dir = pagina_usuario;
+}
+
+/*
  *
+ * Funciones auxiliares de los mutex, que no usan los registros ni cambian
+ * de contexto, por lo que sirven para los mutex de un proceso que termina
+ *	liberar_mutex soltar_mutex cerrar_mutex_proceso
  */
-static void liberar_proceso() {
-    BCP *p_proc_anterior;
-    int i;
-    for (i = 0; i < NUM_MUT_PROC; ++i) {
-        if (p_proc_actual->descriptoresMutex[i] != -1) {
-            escribir_registro(1, p_proc_actual->descriptoresMutex[i]);
-            sis_cerrar_mutex();
-        }
+
+/*
+ * Elimina el mutex de la posicion indicada y, si hay procesos bloqueados
+ * en crear_mutex porque no cabian mas, pasa a listo el primero para que
+ * lo vuelva a intentar
+ */
+static void liberar_mutex(int posicion) {
+    BCP *proc;
+
+    numMutex--;
+    free(lista_mutex[posicion]->nombre);
+    free(lista_mutex[posicion]);
+    lista_mutex[posicion] = NULL;
+
+    if ((proc = lista_bloqueados_mutex.primero) != NULL) {
+        eliminar_primero(&lista_bloqueados_mutex);
+        proc->estado = LISTO;
+        insertar_listo(proc);
     }
+}
+
+/*
+ * Suelta del todo (aunque sea recursivo y se haya bloqueado varias veces)
+ * un mutex cuyo propietario termina. Si hay procesos esperandolo, el
+ * primero pasa a ser el propietario y a listo.
+ */
+static void soltar_mutex(Mutexptr mutex) {
+    BCP *proc = mutex->lista_Procesos_Esperando.primero;
 
+    if (proc == NULL) {
+        mutex->estado = UNLOCKED;
+        mutex->bloqueos = 0;
+        mutex->proceso = -1;
+        return;
+    }
+    eliminar_primero(&mutex->lista_Procesos_Esperando);
+    mutex->proc_esperando--;
+    mutex->proceso = proc->id;
+    if (mutex->tipo == RECURSIVO)
+        mutex->bloqueos = 1;
+    proc->estado = LISTO;
+    insertar_listo(proc);
+}
 
-    liberar_imagen(p_proc_actual->info_mem); /* liberar mapa */
+/*
+ * Cierra los mutex que un proceso que termina aun tiene abiertos, con el
+ * mismo efecto que cerrar_mutex: suelta los que tiene bloqueados y
+ * elimina los que quedan libres
+ */
+static void cerrar_mutex_proceso(BCP *proc) {
+    Mutexptr mutex;
+    int i, desc;
+
+    for (i = 0; i < NUM_MUT_PROC; i++) {
+        desc = proc->descriptoresMutex[i];
+        if (desc == -1)
+            continue;
+        proc->descriptoresMutex[i] = -1;
+        mutex = lista_mutex[desc];
+        if (mutex == NULL || mutex->id != desc)
+            continue;
+        if (mutex->proceso == proc->id)
+            soltar_mutex(mutex);
+        if (mutex->proceso == -1)
+            liberar_mutex(desc);
+    }
+}
 
-    p_proc_actual->estado = TERMINADO;
-    eliminar_primero(&lista_listos); /* proc. fuera de listos */
+/*
+ *
+ * Funcion auxiliar que termina proceso actual. Solo lo desengancha (de
+ * sus temporizadores, de sus mutex y de quien espera su fin) y lo deja en
+ * la cola del recolector, que liberara sus recursos mas tarde. Usada por llamada
+ * terminar_proceso y por rutinas que tratan excepciones
+ *
+ */
+static void liberar_proceso(int estado_fin) {
+    BCP *p_proc_anterior;
+    BCP *proc;
+
+    fijar_nivel_int(NIVEL_3);
+    liberar_temporizadores(p_proc_actual);
+    cerrar_mutex_proceso(p_proc_actual);
+
+    /* si tiene padre queda zombi hasta que este recoja su estado; se
+       despierta al padre si ya lo estaba esperando */
+    p_proc_actual->estado_fin = estado_fin;
+    if (p_proc_actual->padre != NULL) {
+        p_proc_actual->estado = ZOMBI;
+        while ((proc = p_proc_actual->esperando_fin.primero) != NULL) {
+            eliminar_primero(&p_proc_actual->esperando_fin);
+            proc->estado = LISTO;
+            insertar_listo(proc);
+        }
+    } else
+        p_proc_actual->estado = TERMINADO;
+    p_proc_actual->por_recoger = 1;
+    insertar_ultimo(&lista_por_recoger, p_proc_actual);
 
     /* Realizar cambio de contexto */
     p_proc_anterior = p_proc_actual;
@@ -154,8 +1807,6 @@ static void liberar_proceso() {
     printk("-> C.CONTEXTO POR FIN: de %d a %d\n",
            p_proc_anterior->id, p_proc_actual->id);
 
-    liberar_pila(p_proc_anterior->pila);
-
     cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
     return; /* no deber�a llegar aqui */
 }
@@ -181,7 +1832,7 @@ static void exc_arit() {
 
 
     printk("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
-    liberar_proceso();
+    liberar_proceso(ESTADO_FIN_ANORMAL);
 
     return; /* no deber�a llegar aqui */
 }
@@ -196,7 +1847,7 @@ static void exc_mem() {
 
 
     printk("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
-    liberar_proceso();
+    liberar_proceso(ESTADO_FIN_ANORMAL);
 
     return; /* no deber�a llegar aqui */
 }
@@ -218,30 +1869,15 @@ static void int_terminal() {
  */
 static void int_reloj() {
     int nivel = fijar_nivel_int(NIVEL_3);
+    /* con tick dinamico una interrupcion puede equivaler a varios ticks */
+    unsigned int transcurridos = ticks_por_int;
     printk("-> TRATANDO INT. DE RELOJ\n");
-    // Tratar procesos dormidos
-    BCPptr dormidoActual = lista_dormidos.primero;
-    while (dormidoActual != NULL) {
-        (dormidoActual->segundosDormido)--;
-        if (dormidoActual->segundosDormido < 0) {
-            halt();
-        }
-        if (dormidoActual->segundosDormido == 0) {
-            dormidoActual->estado = LISTO;
-            eliminar_elem(&lista_dormidos, dormidoActual);
-            insertar_ultimo(&lista_listos, dormidoActual);
-        }
-        dormidoActual = dormidoActual->siguiente;
-    }
-
-
-    // Tratar Rodajas Round Robin
-    if(p_proc_actual->estado == LISTO){
-        if(p_proc_actual->ticksRestantes > 0)p_proc_actual->ticksRestantes--;
-        if(p_proc_actual->ticksRestantes == 0){
-            activar_int_SW();
-        }
-    }
+    avanzar_reloj(transcurridos);
+    ajustar_tick();
+    /* si hay procesos ejecutando el recolector se adelanta a la tarea
+       ociosa con un lote acotado en la interrupcion SW */
+    if (lista_por_recoger.primero != NULL && p_proc_actual != &bcp_ocioso)
+        activar_int_SW();
     fijar_nivel_int(nivel);
     return;
 }
@@ -262,67 +1898,173 @@ static void tratar_llamsis() {
 }
 
 /*
- * Tratamiento de interrupciuones software
+ * Retira la UCP al proceso de tiempo real actual, que ha agotado su
+ * presupuesto, hasta su siguiente activacion (su plazo actual). Como no
+ * podra terminar el trabajo a tiempo se cuenta ya el fallo de plazo.
+ */
+static void estrangular_tiempo_real(int nivel) {
+    BCPptr anterior = p_proc_actual;
+    unsigned long long activacion = anterior->plazo;
+
+    anterior->estrangulado = 0;
+    anterior->fallos_plazo++;
+    anterior->plazo += anterior->periodo;
+    anterior->presupuesto_restante = anterior->presupuesto;
+    if (activacion <= ticks_sistema) {
+        fijar_nivel_int(nivel);
+        return;
+    }
+
+    anterior->estado = BLOQUEADO;
+    insertar_dormido(anterior, activacion);
+    p_proc_actual = planificador();
+    printf("C.CONTEXTO DE %d A %d por PRESUPUESTO\n", anterior->id,
+           p_proc_actual->id);
+    fijar_nivel_int(nivel);
+    cambio_contexto(&(anterior->contexto_regs), &(p_proc_actual->contexto_regs));
+}
+
+/*
+ * Tratamiento de interrupciuones software. Expulsa al proceso actual si
+ * su grupo ha agotado la cuota, si hay listo otro de una clase superior o
+ * si lo decide su clase (por haber agotado la rodaja o por haber otro
+ * listo preferente).
  */
 static void int_sw() {
-    int nivel;
+    int nivel, agotada;
+    char *motivo;
     printk("-> TRATANDO INT. SW\n");
-    if(lista_listos.primero == lista_listos.ultimo){
-        p_proc_actual->ticksRestantes = TICKS_POR_RODAJA;
-    }
-    else{
-        nivel = fijar_nivel_int(NIVEL_1);
-        BCPptr anterior = p_proc_actual;
-        eliminar_primero(&lista_listos);
-        insertar_ultimo(&lista_listos, anterior);
-        p_proc_actual = planificador();
-        printf("C.CONTEXTO DE %d A %d por RR\n", anterior->id, p_proc_actual->id);
+    if (p_proc_actual->estado != EJECUCION)
+        return;
+    recoger_terminados(RECOGIDOS_POR_TICK);
+
+    if (p_proc_actual->limite_duro != 0 &&
+        p_proc_actual->tiempo_ucp >= p_proc_actual->limite_duro) {
+        printk("-> PROC %d: LIMITE DURO DE UCP ALCANZADO (%u TICKS)\n",
+               p_proc_actual->id, p_proc_actual->limite_duro);
+        liberar_proceso(ESTADO_FIN_ANORMAL);
+        return; /* no deberia llegar aqui */
+    }
+
+    nivel = fijar_nivel_int(NIVEL_1);
+    if (p_proc_actual->tiempo_real && p_proc_actual->presupuesto_restante == 0) {
+        estrangular_tiempo_real(nivel);
+        return;
+    }
+    agotada = (p_proc_actual->ticksRestantes == 0);
+    if (grupo_estrangulado(p_proc_actual))
+        motivo = "CUOTA";
+    else if (!p_proc_actual->tiempo_real && clase_tiempo_real.elegir_siguiente())
+        motivo = "TIEMPO REAL";
+    else if (clase_de(p_proc_actual)->ceder(p_proc_actual, agotada))
+        motivo = agotada ? "RODAJA" : "EXPULSION";
+    else {
         fijar_nivel_int(nivel);
-        cambio_contexto(&(anterior->contexto_regs), &(p_proc_actual->contexto_regs));
+        return;
+    }
+
+    BCPptr anterior = p_proc_actual;
+    anterior->estado = LISTO;
+    insertar_listo(anterior);
+    p_proc_actual = planificador();
+    printf("C.CONTEXTO DE %d A %d por %s\n", anterior->id, p_proc_actual->id,
+           motivo);
+    fijar_nivel_int(nivel);
+    cambio_contexto(&(anterior->contexto_regs), &(p_proc_actual->contexto_regs));
+}
+
+/*
+ *
+ * Funcion auxiliar que rellena el BCP de un proceso nuevo con su imagen
+ * y una pila de la reserva, sin insertarlo en listos. Usada por
+ * crear_tarea y por la llamada crear_procesos.
+ *
+ */
+static void iniciar_BCP(BCP *p_proc, void *imagen, void *pc_inicial) {
+    int i;
+
+    p_proc->info_mem = imagen;
+    p_proc->pila = obtener_pila();
+    fijar_contexto_ini(p_proc->info_mem, p_proc->pila, TAM_PILA,
+                       pc_inicial,
+                       &(p_proc->contexto_regs));
+    p_proc->estado = LISTO;
+
+    p_proc->despertar = 0;
+    for (i = 0; i < NUM_MUT_PROC; i++) {
+        p_proc->descriptoresMutex[i] = -1;
     }
+
+    p_proc->prioridad = PRIORIDAD_DEFECTO;
+    p_proc->tiempo_virtual = tiempo_virtual_min;
+    p_proc->tickets = TICKETS_DEFECTO;
+    p_proc->zancada = ZANCADA_BASE / TICKETS_DEFECTO;
+    p_proc->pase = pase_global + p_proc->zancada;
+    p_proc->tiempo_real = 0;
+    p_proc->estrangulado = 0;
+    p_proc->fallos_plazo = 0;
+    p_proc->excesos_presupuesto = 0;
+    p_proc->pos_monticulo = -1;
+    /* hereda el grupo y los limites de UCP del proceso que lo crea */
+    p_proc->grupo = -1;
+    p_proc->limite_blando = 0;
+    p_proc->limite_duro = 0;
+    if (p_proc_actual != NULL) {
+        p_proc->grupo = p_proc_actual->grupo;
+        p_proc->limite_blando = p_proc_actual->limite_blando;
+        p_proc->limite_duro = p_proc_actual->limite_duro;
+    }
+    p_proc->holgura = (p_proc_actual != NULL) ? p_proc_actual->holgura
+                                              : HOLGURA_DEFECTO;
+    p_proc->tiempo_ucp = 0;
+    p_proc->aviso_limite = 0;
+    p_proc->avisos_pendientes = 0;
+    p_proc->padre = p_proc_actual;
+    if (p_proc_actual != NULL)
+        p_proc_actual->num_hijos++;
+    p_proc->num_hijos = 0;
+    p_proc->esperando_fin.primero = NULL;
+    p_proc->esperando_fin.ultimo = NULL;
+    p_proc->funcion_hilo = NULL;
+    p_proc->arg_hilo = NULL;
+    p_proc->por_recoger = 0;
+    clase_normal->iniciar(p_proc);
 }
 
 /*
  *
  * Funcion auxiliar que crea un proceso reservando sus recursos.
- * Usada por llamada crear_proceso.
+ * Usada por llamada crear_proceso. Devuelve el identificador del
+ * proceso o -1 si no se ha podido crear.
  *
  */
 static int crear_tarea(char *prog) {
     void *imagen, *pc_inicial;
-    int error = 0;
-    int proc, i;
+    int error = 0, nivel;
     BCP *p_proc;
 
-    proc = buscar_BCP_libre();
-    if (proc == -1)
+    p_proc = obtener_BCP();
+    if (p_proc == NULL)
         return -1;    /* no hay entrada libre */
 
-    /* A rellenar el BCP ... */
-    p_proc = &(tabla_procs[proc]);
-
-    /* crea la imagen de memoria leyendo ejecutable */
-    imagen = crear_imagen(prog, &pc_inicial);
+    /* crea la imagen de memoria leyendo ejecutable, si no esta ya en la
+       cache */
+    imagen = cargar_imagen(prog, &pc_inicial, 1);
     if (imagen) {
-        p_proc->info_mem = imagen;
-        p_proc->pila = crear_pila(TAM_PILA);
-        fijar_contexto_ini(p_proc->info_mem, p_proc->pila, TAM_PILA,
-                           pc_inicial,
-                           &(p_proc->contexto_regs));
-        p_proc->id = proc;
-        p_proc->estado = LISTO;
-
-        p_proc->segundosDormido = 0;
-        for (i = 0; i < NUM_MUT_PROC; i++) {
-            p_proc->descriptoresMutex[i] = -1;
-        }
-
-        p_proc->ticksRestantes = TICKS_POR_RODAJA;
-        /* lo inserta al final de cola de listos */
-        insertar_ultimo(&lista_listos, p_proc);
-        error = 0;
-    } else
+        mapear_pagina_sistema(imagen);
+        /* A rellenar el BCP ... */
+        iniciar_BCP(p_proc, imagen, pc_inicial);
+        /* lo inserta en el conjunto de listos de su clase, que tambien
+           modifica la int. de reloj */
+        nivel = fijar_nivel_int(NIVEL_3);
+        insertar_listo(p_proc);
+        comprobar_expulsion(p_proc);
+        fijar_nivel_int(nivel);
+        error = p_proc->id;
+    } else {
+        liberar_BCP(p_proc);
         error = -1; /* fallo al crear imagen */
+    }
 
     return error;
 }
@@ -336,7 +2078,8 @@ static int crear_tarea(char *prog) {
 
 /*
  * Tratamiento de llamada al sistema crear_proceso. Llama a la
- * funcion auxiliar crear_tarea sis_terminar_proceso
+ * funcion auxiliar crear_tarea sis_terminar_proceso y devuelve el
+ * identificador del nuevo proceso o -1
  */
 int sis_crear_proceso() {
     char *prog;
@@ -348,6 +2091,51 @@ int sis_crear_proceso() {
     return res;
 }
 
+/*
+ * Tratamiento de llamada al sistema crear_procesos. Crea n procesos del
+ * mismo programa de una vez: reserva los n BCPs, carga la imagen una sola
+ * vez para todos, construye sus contextos en una pasada y los pasa a
+ * listos empalmando la lista entera. Guarda sus identificadores en "ids"
+ * y devuelve n, o -1 sin crear ninguno (tambien si la imagen no cabe en la
+ * cache de imagenes, ya que fuera de ella no se puede compartir).
+ */
+int sis_crear_procesos() {
+    char *prog = (char *) leer_registro(1);
+    unsigned int n = (unsigned int) leer_registro(2);
+    int *ids = (int *) leer_registro(3);
+    void *imagen, *pc_inicial;
+    lista_BCPs lote;
+    BCP *proc;
+    int i, nivel;
+
+    printk("-> PROC %d: CREAR %u PROCESOS\n", p_proc_actual->id, n);
+    if (n == 0 || n > MAX_PROC || ids == NULL)
+        return -1;
+    if (obtener_BCPs(n, &lote) < 0)
+        return -1;
+    imagen = cargar_imagen(prog, &pc_inicial, n);
+    if (imagen == NULL) {
+        while ((proc = lote.primero) != NULL) {
+            eliminar_primero(&lote);
+            liberar_BCP(proc);
+        }
+        return -1;
+    }
+    mapear_pagina_sistema(imagen);
+
+    for (proc = lote.primero, i = 0; proc != NULL; proc = proc->siguiente) {
+        iniciar_BCP(proc, imagen, pc_inicial);
+        ids[i++] = proc->id;
+    }
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    proc = lote.primero;
+    insertar_listos_nuevos(&lote);
+    comprobar_expulsion(proc);
+    fijar_nivel_int(nivel);
+    return (int) n;
+}
+
 /*
  * Tratamiento de llamada al sistema escribir. Llama simplemente a la
  * funcion de apoyo escribir_ker
@@ -371,18 +2159,20 @@ int sis_terminar_proceso() {
 
     printk("-> FIN PROCESO %d\n", p_proc_actual->id);
 
-    liberar_proceso();
+    liberar_proceso(ESTADO_FIN_NORMAL);
 
     return 0; /* no deber�a llegar aqui */
 }
 
 
-//TODO llamada dormir
-int sis_dormir() {
-    unsigned int segundos = (unsigned int) leer_registro(1);
+/*
+ * Funcion auxiliar que duerme al proceso actual hasta el tick absoluto
+ * indicado. La usan todas las llamadas dormir.
+ */
+static void dormir_proceso(unsigned long long tick) {
 
-    //Fijar nivel 1
-    int nivel = fijar_nivel_int(NIVEL_1);
+    //Fijar nivel 3 (el reloj tambien maneja los dormidos)
+    int nivel = fijar_nivel_int(NIVEL_3);
 
     //Variable local proceso a dormir
     BCPptr proceso_dormir = p_proc_actual;
@@ -390,13 +2180,9 @@ int sis_dormir() {
 
     //Cambiar estado del proceso
     proceso_dormir->estado = BLOQUEADO;
-    proceso_dormir->segundosDormido = segundos * TICK;
-
-    //Eliminar el proceso de la lista de listos
-    eliminar_primero(&lista_listos);
 
-    //Añadir proceso a lista de bloqueados
-    insertar_ultimo(&lista_dormidos, proceso_dormir);
+    //Añadir proceso a los dormidos hasta su tick de despertar
+    insertar_dormido(proceso_dormir, tick);
 
 
 
@@ -408,10 +2194,45 @@ int sis_dormir() {
 
     //Vuelves a permitir interrupciones
     fijar_nivel_int(nivel);
+}
+
+//TODO llamada dormir
+int sis_dormir() {
+    unsigned int segundos = (unsigned int) leer_registro(1);
+
+    sincronizar_reloj();
+    dormir_proceso(ticks_sistema + (unsigned long long) segundos * TICK);
+    return 0;
+}
 
+/*
+ * Tratamiento de llamada al sistema dormir_ms. Duerme al proceso actual
+ * los milisegundos indicados, redondeados hacia arriba a ticks.
+ */
+int sis_dormir_ms() {
+    unsigned int milisegundos = (unsigned int) leer_registro(1);
+
+    sincronizar_reloj();
+    dormir_proceso(ticks_sistema +
+                   ((unsigned long long) milisegundos * TICK + 999) / 1000);
     return 0;
 }
 
+/*
+ * Tratamiento de llamada al sistema dormir_hasta. Duerme al proceso actual
+ * hasta el tick absoluto indicado, sin esperar si ya ha pasado, y
+ * devuelve el tick actual al despertar. Un bucle periodico que duerme
+ * hasta su siguiente activacion no acumula deriva.
+ */
+int sis_dormir_hasta() {
+    unsigned long tick = (unsigned long) leer_registro(1);
+
+    sincronizar_reloj();
+    if (tick > ticks_sistema)
+        dormir_proceso(tick);
+    return (int) ticks_sistema;
+}
+
 
 //TODO servicio obtener_id_pr
 /*
@@ -441,30 +2262,30 @@ int sis_crear_mutex() {
     if (strlen(nombre) > MAX_NOM_MUT)
         return -2;
 
-    //Comprobar nombres duplicados
-    for (i = 0; i < NUM_MUT && !encontrado; i++) {
-        if (lista_mutex[i] != NULL && !strcmp(nombre, lista_mutex[i]->nombre)) {
-            encontrado = 1;
+    //Si no caben mas mutex, bloquearse hasta que se elimine alguno y
+    //volver a comprobarlo todo
+    for (;;) {
+        //Comprobar nombres duplicados
+        for (encontrado = 0, i = 0; i < NUM_MUT && !encontrado; i++) {
+            if (lista_mutex[i] != NULL && !strcmp(nombre, lista_mutex[i]->nombre)) {
+                encontrado = 1;
+            }
         }
-    }
-    if (encontrado)return -1;     // Si existe otro mutex con ese nombre, finalizar con error3
-
-    //comprobar descriptores libres para el proceso
-    for (encontrado = 0, i = 0; i < NUM_MUT_PROC && !encontrado; ++i) {
-        if (p_proc_actual->descriptoresMutex[i] == -1)encontrado = 1;
-    }
-    if (!encontrado)return -5;
+        if (encontrado)return -1;     // Si existe otro mutex con ese nombre, finalizar con error3
 
+        //comprobar descriptores libres para el proceso
+        for (encontrado = 0, i = 0; i < NUM_MUT_PROC && !encontrado; ++i) {
+            if (p_proc_actual->descriptoresMutex[i] == -1)encontrado = 1;
+        }
+        if (!encontrado)return -5;
 
-    if (numMutex >= NUM_MUT) {
+        if (numMutex < NUM_MUT)
+            break;
         procesoBloquear = p_proc_actual;
         procesoBloquear->estado = BLOQUEADO;
-        eliminar_primero(&lista_listos);
         insertar_ultimo(&lista_bloqueados_mutex, procesoBloquear);
         p_proc_actual = planificador();
         cambio_contexto(&(procesoBloquear->contexto_regs), &(p_proc_actual->contexto_regs));
-        fijar_nivel_int(nivel);
-        return 0;
     }
 
     numMutex++;
@@ -594,8 +2415,6 @@ int sis_lock() {
             BCPptr proceso_bloquear = p_proc_actual;
             proceso_bloquear->estado = BLOQUEADO;
 
-
-            eliminar_primero(&lista_listos);
             insertar_ultimo(&(mutex->lista_Procesos_Esperando), proceso_bloquear);
 
 
@@ -660,7 +2479,8 @@ int sis_unlock() {
 
 
         eliminar_primero(&(mutex->lista_Procesos_Esperando));
-        insertar_ultimo(&lista_listos, procesoLiberado);
+        insertar_listo(procesoLiberado);
+        comprobar_expulsion(procesoLiberado);
 
 //        printf("Estado proceso desbloquear2:%d, %d, %p, %p, %p, %d\n", procesoLiberado->id, procesoLiberado->estado,
 //               procesoLiberado->pila,
@@ -708,7 +2528,8 @@ int sis_cerrar_mutex() {
             encontrado = 1;
         }
     }
-    //Si nadie está usando en mutex, liberarlo
+    //Si nadie está usando en mutex, liberarlo (despierta a un proceso
+    //bloqueado en crear_mutex, si lo hay)
     if (mutex->proceso == -1) {
         encontrado = 0;
         int posicion = 0;
@@ -718,56 +2539,637 @@ int sis_cerrar_mutex() {
                 posicion = i;
             }
         }
+        liberar_mutex(posicion);
+    }
 
-        //Comprobar si hay procesos bloqueados esperando por un mutex
-        if (lista_bloqueados_mutex.primero != NULL) {
-            BCPptr procesoLiberar = lista_bloqueados_mutex.primero;
-
-            procesoLiberar->estado = LISTO;
-            eliminar_primero(&lista_bloqueados_mutex);
-            insertar_ultimo(&lista_listos, procesoLiberar);
-            lista_mutex[i]->proceso = procesoLiberar->id;
-
-            cambio_contexto(&(p_proc_actual->contexto_regs), &(procesoLiberar->contexto_regs));
-            char *nombre = (char*) leer_registro(1);
-            for (i = 0, encontrado = 0; i < NUM_MUT && !encontrado; i++) {
-                if (lista_mutex[i] != NULL && !strcmp(nombre, lista_mutex[i]->nombre)) {
-                    encontrado = 1;
-                }
-            }
-            if (encontrado){
-                escribir_registro(0, -1);
-                return -1;
-            }
-            free(mutex->nombre);
-            mutex->nombre = malloc(sizeof(char) * NUM_MUT);
-            strcpy(mutex->nombre, nombre);
-            escribir_registro(0,lista_mutex[i]->id);
+    fijar_nivel_int(nivel);
+    return 0;
+}
 
-            cambio_contexto(&(procesoLiberar->contexto_regs), &(p_proc_actual->contexto_regs));
 
-        }
-        else{
-            numMutex--;
-            free(mutex->nombre);
-            free(lista_mutex[posicion]);
-            lista_mutex[posicion] = NULL;
+int sis_leer_caracter() {
+    char a;
+    scanf("%c", &a);
+    return a;
+}
 
-        }
+/*
+ * Tratamiento de llamada al sistema fijar_prioridad. Cambia la prioridad
+ * de un proceso moviendolo de cola si esta listo y provoca una expulsion
+ * si el cambio deja a otro proceso por delante del actual.
+ */
+int sis_fijar_prioridad() {
+    int id = (int) leer_registro(1);
+    int prioridad = (int) leer_registro(2);
+    int nivel;
+    BCP *proc;
 
+    if (prioridad < PRIORIDAD_MAXIMA || prioridad > PRIORIDAD_MINIMA)
+        return -1;
+    if (politica_planif == PLANIF_MLFQ && prioridad >= NIVELES_MLFQ)
+        return -1;
 
+    nivel = fijar_nivel_int(NIVEL_3);
+    proc = buscar_proceso(id);
+    if (proc == NULL) {
+        fijar_nivel_int(nivel);
+        return -1;
+    }
 
+    if (proc->estado == LISTO) {
+        eliminar_listo(proc);
+        proc->prioridad = prioridad;
+        insertar_listo(proc);
+        comprobar_expulsion(proc);
+    } else {
+        proc->prioridad = prioridad;
+        if (proc == p_proc_actual)
+            activar_int_SW();
     }
+    if (politica_planif == PLANIF_MLFQ && proc->ticksRestantes > rodaja_mlfq(proc))
+        proc->ticksRestantes = rodaja_mlfq(proc);
 
     fijar_nivel_int(nivel);
     return 0;
 }
 
+/*
+ * Tratamiento de llamada al sistema fijar_tiempo_real. El proceso actual
+ * declara su periodo y su presupuesto por periodo (en ticks) y pasa a la
+ * clase de tiempo real si la utilizacion total no supera el 100%. Con
+ * periodo 0 vuelve a ser un proceso normal.
+ */
+int sis_fijar_tiempo_real() {
+    unsigned int periodo = (unsigned int) leer_registro(1);
+    unsigned int presupuesto = (unsigned int) leer_registro(2);
+    unsigned long long utilizacion;
+    int nivel;
 
-int sis_leer_caracter() {
-    char a;
-    scanf("%c", &a);
-    return a;
+    if (periodo != 0 && (presupuesto == 0 || presupuesto > periodo))
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    if (p_proc_actual->tiempo_real) {
+        utilizacion_tiempo_real -= p_proc_actual->utilizacion;
+        p_proc_actual->tiempo_real = 0;
+    }
+    if (periodo == 0) {
+        activar_int_SW();
+        fijar_nivel_int(nivel);
+        return 0;
+    }
+
+    /* redondeo hacia arriba para no admitir nunca de mas */
+    utilizacion = ((unsigned long long) presupuesto * UTILIZACION_MAXIMA +
+                   periodo - 1) / periodo;
+    if (utilizacion_tiempo_real + utilizacion > UTILIZACION_MAXIMA) {
+        fijar_nivel_int(nivel);
+        return -2;      /* rechazado por control de admision */
+    }
+
+    utilizacion_tiempo_real += utilizacion;
+    p_proc_actual->utilizacion = utilizacion;
+    p_proc_actual->periodo = periodo;
+    p_proc_actual->presupuesto = presupuesto;
+    p_proc_actual->presupuesto_restante = presupuesto;
+    p_proc_actual->plazo = ticks_sistema + periodo;
+    p_proc_actual->estrangulado = 0;
+    p_proc_actual->tiempo_real = 1;
+    ajustar_tick();
+
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema esperar_periodo. El proceso de tiempo
+ * real actual da por terminado el trabajo del periodo y se bloquea hasta
+ * su siguiente activacion, que coincide con su plazo. Devuelve el numero
+ * de fallos de plazo acumulados.
+ */
+int sis_esperar_periodo() {
+    unsigned long long activacion;
+    int nivel;
+    BCPptr proceso_esperar = p_proc_actual;
+
+    if (!proceso_esperar->tiempo_real)
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    if (ticks_sistema >= proceso_esperar->plazo) {
+        proceso_esperar->fallos_plazo++;
+        while (proceso_esperar->plazo <= ticks_sistema)
+            proceso_esperar->plazo += proceso_esperar->periodo;
+    }
+
+    activacion = proceso_esperar->plazo;
+    proceso_esperar->plazo += proceso_esperar->periodo;
+    proceso_esperar->presupuesto_restante = proceso_esperar->presupuesto;
+    proceso_esperar->estrangulado = 0;
+
+    proceso_esperar->estado = BLOQUEADO;
+    insertar_dormido(proceso_esperar, activacion);
+
+    p_proc_actual = planificador();
+    cambio_contexto(&(proceso_esperar->contexto_regs),
+                    &(p_proc_actual->contexto_regs));
+
+    fijar_nivel_int(nivel);
+    return proceso_esperar->fallos_plazo;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_tickets. Cambia los tickets de
+ * un proceso para la planificacion por zancadas, reescalando el pase que
+ * le queda por recorrer respecto al global con la nueva zancada.
+ */
+int sis_fijar_tickets() {
+    int id = (int) leer_registro(1);
+    unsigned int tickets = (unsigned int) leer_registro(2);
+    unsigned int zancada;
+    long long restante;
+    int nivel, listo;
+    BCP *proc;
+
+    if (tickets < 1 || tickets > MAX_TICKETS)
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    proc = buscar_proceso(id);
+    if (proc == NULL) {
+        fijar_nivel_int(nivel);
+        return -1;
+    }
+
+    listo = (proc->estado == LISTO);
+    if (listo)
+        eliminar_listo(proc);
+
+    zancada = ZANCADA_BASE / tickets;
+    restante = (long long) (proc->pase - pase_global);
+    restante = restante * zancada / proc->zancada;
+    proc->pase = pase_global + restante;
+    proc->zancada = zancada;
+    proc->tickets = tickets;
+
+    if (listo)
+        insertar_listo(proc);
+
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema ceder_cpu. El proceso actual pasa al
+ * final de su cola de listos y cede la UCP al que elija el planificador,
+ * sin esperar a agotar la rodaja. Si no hay otro listo, o el planificador
+ * lo vuelve a elegir por ser el preferido de su clase, sigue ejecutando.
+ */
+int sis_ceder_cpu() {
+    int nivel;
+    BCPptr anterior = p_proc_actual;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    if (!hay_listos()) {
+        fijar_nivel_int(nivel);
+        return 0;
+    }
+
+    /* como en int_sw, se reinserta antes de elegir */
+    anterior->estado = LISTO;
+    insertar_listo(anterior);
+    p_proc_actual = planificador();
+    if (p_proc_actual == anterior) {
+        fijar_nivel_int(nivel);
+        return 0;
+    }
+    printk("-> C.CONTEXTO POR CESION: de %d a %d\n", anterior->id,
+           p_proc_actual->id);
+    cambio_contexto(&(anterior->contexto_regs), &(p_proc_actual->contexto_regs));
+
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema ceder_a. El proceso actual cede el
+ * resto de su rodaja directamente al proceso listo indicado y pasa al
+ * final de su cola de listos. Devuelve -1 si ese proceso no esta listo.
+ */
+int sis_ceder_a() {
+    int id = (int) leer_registro(1);
+    int nivel;
+    BCPptr anterior = p_proc_actual;
+    BCP *proc;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    proc = buscar_proceso(id);
+    if (proc == NULL || proc->estado != LISTO || grupo_estrangulado(proc)) {
+        fijar_nivel_int(nivel);
+        return -1;
+    }
+
+    eliminar_listo(proc);
+    if (anterior->ticksRestantes > 0)
+        proc->ticksRestantes = anterior->ticksRestantes;
+    proc->estado = EJECUCION;
+    p_proc_actual = proc;
+    publicar_proceso(proc);
+    anterior->estado = LISTO;
+    insertar_listo(anterior);
+    printk("-> C.CONTEXTO POR CESION: de %d a %d\n", anterior->id,
+           p_proc_actual->id);
+    cambio_contexto(&(anterior->contexto_regs), &(p_proc_actual->contexto_regs));
+
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_grupo. Crea un grupo de procesos
+ * que puede consumir como mucho "cuota" ticks de UCP en cada periodo de
+ * PERIODO_GRUPOS ticks (0 = sin limite). Devuelve su descriptor o -1.
+ */
+int sis_crear_grupo() {
+    unsigned int cuota = (unsigned int) leer_registro(1);
+    int i;
+
+    if (cuota > PERIODO_GRUPOS)
+        return -1;
+
+    for (i = 0; i < MAX_GRUPOS && grupos[i].usado; i++);
+    if (i == MAX_GRUPOS)
+        return -1;      /* no quedan grupos libres */
+
+    grupos[i].usado = 1;
+    grupos[i].cuota = cuota;
+    grupos[i].consumido = 0;
+    grupos[i].total = 0;
+    grupos[i].estrangulado = 0;
+    grupos[i].estrangulados.primero = NULL;
+    grupos[i].estrangulados.ultimo = NULL;
+    return i;
+}
+
+/*
+ * Tratamiento de llamada al sistema unir_grupo. El proceso actual pasa al
+ * grupo indicado (-1 para no pertenecer a ninguno); los procesos que cree
+ * despues lo heredan.
+ */
+int sis_unir_grupo() {
+    int grupo = (int) leer_registro(1);
+    int nivel;
+
+    if (grupo < -1 || grupo >= MAX_GRUPOS || (grupo != -1 && !grupos[grupo].usado))
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    p_proc_actual->grupo = grupo;
+    if (grupo_estrangulado(p_proc_actual))
+        activar_int_SW();
+    ajustar_tick();
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema leer_uso_grupo. Devuelve los ticks de
+ * UCP que han consumido los procesos del grupo desde que se creo.
+ */
+int sis_leer_uso_grupo() {
+    int grupo = (int) leer_registro(1);
+
+    if (grupo < 0 || grupo >= MAX_GRUPOS || !grupos[grupo].usado)
+        return -1;
+    return (int) grupos[grupo].total;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_limite_ucp. Fija los limites
+ * blando y duro (en ticks, 0 = sin limite) del tiempo de UCP del proceso
+ * actual, que heredan los procesos que cree. El limite duro solo se
+ * puede reducir, para que un proceso limitado no pueda librarse de el.
+ */
+int sis_fijar_limite_ucp() {
+    unsigned int blando = (unsigned int) leer_registro(1);
+    unsigned int duro = (unsigned int) leer_registro(2);
+    int nivel;
+
+    if (duro != 0 && blando > duro)
+        return -1;
+    if (p_proc_actual->limite_duro != 0 &&
+        (duro == 0 || duro > p_proc_actual->limite_duro))
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    p_proc_actual->limite_blando = blando;
+    p_proc_actual->limite_duro = duro;
+    p_proc_actual->aviso_limite = 0;
+    ajustar_tick();
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema leer_tiempo_ucp. Devuelve los ticks
+ * de UCP que ha consumido el proceso indicado o -1 si no existe.
+ */
+int sis_leer_tiempo_ucp() {
+    int id = (int) leer_registro(1);
+    BCP *proc = buscar_proceso(id);
+
+    if (proc == NULL)
+        return -1;
+    return (int) proc->tiempo_ucp;
+}
+
+/*
+ * Tratamiento de llamada al sistema leer_tiempo_ocioso. Devuelve los ticks
+ * que la UCP ha pasado en la tarea ociosa y, si "total" no es nulo, guarda
+ * en el los ticks transcurridos desde el arranque.
+ */
+int sis_leer_tiempo_ocioso() {
+    unsigned int *total = (unsigned int *) leer_registro(1);
+
+    if (total != NULL)
+        *total = (unsigned int) ticks_sistema;
+    return (int) ticks_ociosos;
+}
+
+/*
+ * Tratamiento de llamada al sistema fijar_holgura. Fija los ticks que se
+ * puede retrasar el despertar del proceso actual para agruparlo con el de
+ * otros dormidos. La heredan los procesos que cree.
+ */
+int sis_fijar_holgura() {
+    unsigned int holgura = (unsigned int) leer_registro(1);
+
+    if (holgura > MAX_HOLGURA)
+        return -1;
+    p_proc_actual->holgura = holgura;
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema obtener_ticks. Devuelve los ticks de
+ * reloj transcurridos desde el arranque (reloj monotonico), puestos al
+ * dia aunque el tick dinamico haya alargado el periodo del reloj.
+ */
+int sis_obtener_ticks() {
+    sincronizar_reloj();
+    return (int) ticks_sistema;
+}
+
+/*
+ * Tratamiento de llamada al sistema terminar_proceso_estado. Como
+ * terminar_proceso, pero con el valor de terminacion indicado, que
+ * recogera el padre con esperar_proceso
+ */
+int sis_terminar_proceso_estado() {
+    int estado_fin = (int) leer_registro(1);
+
+    printk("-> FIN PROCESO %d CON %d\n", p_proc_actual->id, estado_fin);
+
+    liberar_proceso(estado_fin);
+
+    return 0; /* no deberia llegar aqui */
+}
+
+/*
+ * Tratamiento de llamada al sistema esperar_proceso. Bloquea al proceso
+ * actual hasta que termine el hijo indicado, si no ha terminado ya, guarda
+ * su valor de terminacion en "estado" (si no es nulo) y libera su BCP.
+ * Devuelve -1 si no es un hijo suyo.
+ */
+int sis_esperar_proceso() {
+    int id = (int) leer_registro(1);
+    int *estado = (int *) leer_registro(2);
+    BCPptr proceso_bloquear = p_proc_actual;
+    BCP *hijo = buscar_proceso(id);
+    int nivel;
+
+    if (hijo == NULL || hijo->padre != p_proc_actual)
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    if (hijo->estado != ZOMBI) {
+        proceso_bloquear->estado = BLOQUEADO;
+        insertar_ultimo(&hijo->esperando_fin, proceso_bloquear);
+        p_proc_actual = planificador();
+        cambio_contexto(&(proceso_bloquear->contexto_regs),
+                        &(p_proc_actual->contexto_regs));
+    }
+    if (estado != NULL)
+        *estado = hijo->estado_fin;
+    p_proc_actual->num_hijos--;
+    liberar_zombi(hijo);
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_hilo. Crea un hilo que comparte
+ * la imagen del proceso actual, con su propia pila y contexto, que empieza
+ * en "inicio" (la funcion de la biblioteca que recoge "funcion" y "arg"
+ * con argumentos_hilo). Es hijo del proceso actual, que puede esperarlo con
+ * esperar_proceso. Devuelve su identificador o -1.
+ */
+int sis_crear_hilo() {
+    void *inicio = (void *) leer_registro(1);
+    void *funcion = (void *) leer_registro(2);
+    void *arg = (void *) leer_registro(3);
+    int nivel;
+    BCP *p_proc;
+
+    printk("-> PROC %d: CREAR HILO\n", p_proc_actual->id);
+    if (inicio == NULL || funcion == NULL)
+        return -1;
+    p_proc = obtener_BCP();
+    if (p_proc == NULL)
+        return -1;
+    if (retener_imagen(p_proc_actual->info_mem) < 0) {
+        liberar_BCP(p_proc);
+        return -1;
+    }
+
+    iniciar_BCP(p_proc, p_proc_actual->info_mem, inicio);
+    p_proc->funcion_hilo = funcion;
+    p_proc->arg_hilo = arg;
+    nivel = fijar_nivel_int(NIVEL_3);
+    insertar_listo(p_proc);
+    comprobar_expulsion(p_proc);
+    fijar_nivel_int(nivel);
+    return p_proc->id;
+}
+
+/*
+ * Tratamiento de llamada al sistema argumentos_hilo. Devuelve en "funcion"
+ * y "arg" los del hilo actual, o -1 si es un proceso.
+ */
+int sis_argumentos_hilo() {
+    void **funcion = (void **) leer_registro(1);
+    void **arg = (void **) leer_registro(2);
+
+    if (p_proc_actual->funcion_hilo == NULL)
+        return -1;
+    *funcion = p_proc_actual->funcion_hilo;
+    *arg = p_proc_actual->arg_hilo;
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema leer_cache_imagenes. Devuelve las
+ * creaciones de procesos que han encontrado su imagen en la cache y, si
+ * "fallos" no es nulo, guarda ahi las que han tenido que cargarla.
+ */
+int sis_leer_cache_imagenes() {
+    unsigned int *fallos = (unsigned int *) leer_registro(1);
+
+    if (fallos != NULL)
+        *fallos = fallos_imagenes;
+    return (int) aciertos_imagenes;
+}
+
+/*
+ * Devuelve el temporizador con el descriptor indicado si pertenece al
+ * proceso actual o NULL
+ */
+static temporizador *buscar_temporizador(int id) {
+    if (id < 0 || id >= MAX_TEMPORIZADORES || !temporizadores[id].usado ||
+        temporizadores[id].proceso != p_proc_actual)
+        return NULL;
+    return &temporizadores[id];
+}
+
+/*
+ * Tratamiento de llamada al sistema crear_temporizador. Crea y arma un
+ * temporizador que vence a los milisegundos indicados y despues, si
+ * "periodo_ms" no es 0, periodicamente. Con funcion, esta se ejecuta en el
+ * proceso al volver de su siguiente llamada al sistema; sin ella el
+ * proceso espera los vencimientos con esperar_temporizador. Devuelve su
+ * descriptor o -1.
+ */
+int sis_crear_temporizador() {
+    unsigned int milisegundos = (unsigned int) leer_registro(1);
+    unsigned int periodo_ms = (unsigned int) leer_registro(2);
+    void (*funcion)(int) = (void (*)(int)) leer_registro(3);
+    unsigned long long ticks;
+    temporizador *temp;
+    int id, nivel;
+
+    for (id = 0; id < MAX_TEMPORIZADORES; id++)
+        if (!temporizadores[id].usado)
+            break;
+    if (id == MAX_TEMPORIZADORES)
+        return -1;
+
+    sincronizar_reloj();
+    nivel = fijar_nivel_int(NIVEL_3);
+    temp = &temporizadores[id];
+    temp->usado = 1;
+    temp->proceso = p_proc_actual;
+    temp->periodo = (unsigned int) (((unsigned long long) periodo_ms * TICK +
+                                     999) / 1000);
+    if (periodo_ms != 0 && temp->periodo == 0)
+        temp->periodo = 1;
+    temp->funcion = funcion;
+    temp->vencimientos = 0;
+    temp->esperando = 0;
+    ticks = ((unsigned long long) milisegundos * TICK + 999) / 1000;
+    armar_temporizador(temp, ticks_sistema + (ticks != 0 ? ticks : 1));
+    fijar_nivel_int(nivel);
+    return id;
+}
+
+/*
+ * Tratamiento de llamada al sistema esperar_temporizador. Bloquea al
+ * proceso hasta que venza el temporizador sin funcion indicado, si no ha
+ * vencido ya, y devuelve los vencimientos que tenia pendientes. Devuelve
+ * -1 si no es suyo, tiene funcion o no volvera a vencer.
+ */
+int sis_esperar_temporizador() {
+    int id = (int) leer_registro(1);
+    temporizador *temp = buscar_temporizador(id);
+    BCPptr proceso_bloquear = p_proc_actual;
+    unsigned int vencimientos;
+    int nivel;
+
+    if (temp == NULL || temp->funcion != NULL)
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    if (temp->vencimientos == 0) {
+        if (temp->vencimiento == 0) {
+            fijar_nivel_int(nivel);
+            return -1;
+        }
+        temp->esperando = 1;
+        proceso_bloquear->estado = BLOQUEADO;
+        p_proc_actual = planificador();
+        cambio_contexto(&(proceso_bloquear->contexto_regs),
+                        &(p_proc_actual->contexto_regs));
+    }
+    vencimientos = temp->vencimientos;
+    temp->vencimientos = 0;
+    fijar_nivel_int(nivel);
+    return (int) vencimientos;
+}
+
+/*
+ * Tratamiento de llamada al sistema cancelar_temporizador. Desarma y
+ * destruye un temporizador del proceso actual, descartando los avisos que
+ * tuviera pendientes.
+ */
+int sis_cancelar_temporizador() {
+    int id = (int) leer_registro(1);
+    temporizador *temp = buscar_temporizador(id);
+    int nivel;
+
+    if (temp == NULL)
+        return -1;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    desarmar_temporizador(temp);
+    if (temp->funcion != NULL) {
+        p_proc_actual->avisos_pendientes -= temp->vencimientos;
+        publicar_proceso(p_proc_actual);
+    }
+    temp->usado = 0;
+    fijar_nivel_int(nivel);
+    return 0;
+}
+
+/*
+ * Tratamiento de llamada al sistema recoger_aviso, que usa la biblioteca
+ * al volver de una llamada si la pagina del sistema indica que hay avisos
+ * pendientes. Consume un vencimiento de un temporizador con funcion del
+ * proceso actual y devuelve la funcion y el descriptor en las direcciones
+ * indicadas, o -1 si no queda ninguno.
+ */
+int sis_recoger_aviso() {
+    void (**funcion)(int) = (void (**)(int)) leer_registro(1);
+    int *id = (int *) leer_registro(2);
+    int i, nivel;
+
+    nivel = fijar_nivel_int(NIVEL_3);
+    for (i = 0; i < MAX_TEMPORIZADORES; i++)
+        if (temporizadores[i].usado &&
+            temporizadores[i].proceso == p_proc_actual &&
+            temporizadores[i].funcion != NULL &&
+            temporizadores[i].vencimientos > 0)
+            break;
+    if (i == MAX_TEMPORIZADORES) {
+        fijar_nivel_int(nivel);
+        return -1;
+    }
+    temporizadores[i].vencimientos--;
+    p_proc_actual->avisos_pendientes--;
+    publicar_proceso(p_proc_actual);
+    fijar_nivel_int(nivel);
+
+    *funcion = temporizadores[i].funcion;
+    *id = i;
+    return 0;
 }
 
 void lista_mutex_init() {
@@ -791,6 +3193,19 @@ int main() {
     /* se llega con las interrupciones prohibidas */
     lista_mutex_init(); //TODO Inicializar lista de mutex del sistema
 
+    /* politica de planificacion elegida en la variable de entorno */
+    seleccionar_planificador(getenv("PLANIFICADOR"));
+
+    /* tiempo virtual elegido en la variable de entorno */
+    if (getenv("TIEMPO_VIRTUAL") != NULL)
+        tiempo_virtual = atoi(getenv("TIEMPO_VIRTUAL"));
+    if (tiempo_virtual)
+        printk("-> TIEMPO VIRTUAL\n");
+
+    /* pilas y BCPs preparados, segun la variable de entorno */
+    if (getenv("RESERVA_PROCESOS") != NULL)
+        reserva_procesos = atoi(getenv("RESERVA_PROCESOS"));
+
     instal_man_int(EXC_ARITM, exc_arit);
     instal_man_int(EXC_MEM, exc_mem);
     instal_man_int(INT_RELOJ, int_reloj);
@@ -803,6 +3218,9 @@ int main() {
     iniciar_cont_reloj(TICK);    /* fija frecuencia del reloj */
     iniciar_cont_teclado();        /* inici cont. teclado */
     iniciar_tabla_proc();        /* inicia BCPs de tabla de procesos */
+    iniciar_reserva();           /* pilas y BCPs preparados */
+    crear_pagina_sistema();      /* reloj e id. legibles sin llamadas */
+    crear_tarea_ociosa();        /* para cuando no haya listos */
 
     /* crea proceso inicial */
     if (crear_tarea((void *) "init") < 0)
@@ -0,0 +1,50 @@
+/*
+ * usuario/acaparador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que "gasta CPU" por bloques. prueba_grupos crea
+ * tres instancias dentro de un grupo con cuota y una fuera de él. El
+ * primero en completar META bloques muestra cuántos ha completado cada
+ * uno: la instancia sin grupo debe avanzar respecto a la suma de las
+ * otras tres en la proporción que fija la cuota.
+ */
+
+#include "servicios.h"
+
+#define NUM_ACAPARADORES 4	/* instancias que crea prueba_grupos */
+#define META 200		/* bloques del proceso que más avanza */
+#define ITER_BLOQUE 1000000
+
+/* Todas las instancias de un programa comparten sus variables globales,
+   ya que el S.O. carga una sola vez cada ejecutable */
+static volatile int num_creados = 0;
+static volatile int progreso[NUM_ACAPARADORES];
+static volatile int fin = 0;
+
+int main(){
+	int i, j, orden, id;
+	unsigned int tot=0;
+
+	id=obtener_id_pr();
+	orden=num_creados++;
+	if (orden>=NUM_ACAPARADORES)
+		return 0;
+
+	while (!fin) {
+		for (j=0; j<ITER_BLOQUE; j++)
+			tot+=j;
+		if (++progreso[orden]>=META)
+			fin=1;
+	}
+
+	if (progreso[orden]>=META)
+		for (i=0; i<NUM_ACAPARADORES; i++)
+			printf("acaparador %d: %d bloques\n", i, progreso[i]);
+
+	printf("acaparador (%d): termina con %u\n", id, tot);
+	return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * usuario/alternante.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que alterna turnos con otra instancia de sí mismo
+ * mediante una variable compartida. Mientras no es su turno no gasta la
+ * rodaja: la primera instancia cede la UCP con ceder_cpu y la segunda se
+ * la cede directamente a la primera con ceder_a.
+ */
+
+#include "servicios.h"
+
+#define NUM_ALTERNANTES 2	/* instancias que crea prueba_ceder */
+#define RONDAS 5
+
+/* Todas las instancias de un programa comparten sus variables globales,
+   ya que el S.O. carga una sola vez cada ejecutable */
+static volatile int num_creados = 0;
+static volatile int ids[NUM_ALTERNANTES];
+static volatile int turno = 0;
+
+int main(){
+	int i, orden, id, cesiones=0;
+
+	id=obtener_id_pr();
+	orden=num_creados++;
+	if (orden>=NUM_ALTERNANTES)
+		return 0;
+	ids[orden]=id;
+
+	for (i=0; i<RONDAS; i++) {
+		while (turno!=orden) {
+			if (orden==0)
+				ceder_cpu();
+			else if (ceder_a(ids[0])<0)
+				ceder_cpu();
+			cesiones++;
+		}
+		printf("alternante (%d): ronda %d\n", id, i);
+		turno=(orden+1)%NUM_ALTERNANTES;
+	}
+
+	printf("alternante (%d): termina tras %d cesiones\n", id, cesiones);
+	return 0;
+}
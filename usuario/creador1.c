@@ -14,7 +14,7 @@
 #include "servicios.h"
 
 int main(){
-    int error;
+    int error, hijo;
 	printf("creador1 comienza\n");
 	if ((error = crear_mutex("m1", NO_RECURSIVO))<0)
 		printf("error %d creando m1. NO DEBE SALIR\n", error);
@@ -30,8 +30,12 @@ int main(){
 	if (crear_mutex("m4", NO_RECURSIVO)<0)
 		printf("error creando m4. NO DEBE SALIR\n");
 
-	printf("creador1 duerme 1 segundo\n");
-	dormir(1);
+	/* mantiene sus mutex hasta que los use abridor: nulo ejecuta
+	   despues de los procesos ya listos, asi que cuando termina ya han
+	   ejecutado los demas creadores y abridor */
+	printf("creador1 espera a un proceso nulo\n");
+	if ((hijo=crear_proceso("nulo"))<0 || esperar_proceso(hijo, NULL)<0)
+		printf("error esperando a nulo. NO DEBE SALIR\n");
 
 	printf("creador1 termina\n");
 
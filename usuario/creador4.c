@@ -14,6 +14,7 @@
 #include "servicios.h"
 
 int main(){
+	int hijo;
 
 	printf("creador4 comienza\n");
 
@@ -29,8 +30,12 @@ int main(){
 	if (crear_mutex("m16", NO_RECURSIVO)<0)
 		printf("error creando m16. NO DEBE SALIR\n");
 
-	printf("creador4 duerme 1 segundo\n");
-	dormir(1);
+	/* mantiene sus mutex hasta que los use abridor: nulo ejecuta
+	   despues de los procesos ya listos, asi que cuando termina ya han
+	   ejecutado los demas creadores y abridor */
+	printf("creador4 espera a un proceso nulo\n");
+	if ((hijo=crear_proceso("nulo"))<0 || esperar_proceso(hijo, NULL)<0)
+		printf("error esperando a nulo. NO DEBE SALIR\n");
 
 	printf("creador4 termina\n");
 
@@ -0,0 +1,30 @@
+/*
+ * usuario/desbocado.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que entra en un bucle infinito mostrando de vez en
+ * cuando el tiempo de UCP que lleva consumido. Solo termina si tiene un
+ * límite duro de tiempo de UCP.
+ */
+
+#include "servicios.h"
+
+#define ITER_BLOQUE 5000000
+
+int main(){
+	int j, id;
+	unsigned int tot=0;
+
+	id=obtener_id_pr();
+	for (;;) {
+		for (j=0; j<ITER_BLOQUE; j++)
+			tot+=j;
+		printf("desbocado (%d): %d ticks de UCP\n", id,
+			leer_tiempo_ucp(id));
+	}
+	return 0;
+}
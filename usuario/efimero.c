@@ -0,0 +1,18 @@
+/*
+ * usuario/efimero.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que no hace nada más que dormir un segundo, para
+ * tener muchos procesos vivos a la vez. No escribe nada.
+ */
+
+#include "servicios.h"
+
+int main(){
+	dormir(1);
+	return 0;
+}
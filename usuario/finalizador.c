@@ -0,0 +1,22 @@
+/*
+ * usuario/finalizador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que duerme un segundo y termina con su propio
+ * identificador como valor de terminación. Lo usa prueba_esperar.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int id=obtener_id_pr();
+
+	dormir(1);
+	printf("finalizador: proceso %d termina\n", id);
+	terminar_proceso_estado(id);
+	return 0;
+}
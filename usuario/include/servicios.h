@@ -39,6 +39,35 @@ int lock(unsigned int mutexid);
 int unlock(unsigned int mutexid);
 int cerrar_mutex(unsigned int mutexid);
 int leer_caracter();
+int fijar_prioridad(int id, int prioridad);
+int fijar_tickets(int id, unsigned int tickets);
+int fijar_tiempo_real(unsigned int periodo, unsigned int presupuesto);
+int esperar_periodo();
+int ceder_cpu();
+int ceder_a(int id);
+int crear_grupo(unsigned int cuota);
+int unir_grupo(int grupo);
+int leer_uso_grupo(int grupo);
+int fijar_limite_ucp(unsigned int blando, unsigned int duro);
+int leer_tiempo_ucp(int id);
+int leer_tiempo_ocioso(unsigned int *total);
+int dormir_ms(unsigned int milisegundos);
+int dormir_hasta(unsigned long tick);
+int fijar_holgura(unsigned int ticks);
+int obtener_ticks();
+int crear_temporizador(unsigned int milisegundos, unsigned int periodo_ms,
+                       void (*funcion)(int));
+int esperar_temporizador(int id);
+int cancelar_temporizador(int id);
+int leer_cache_imagenes(unsigned int *fallos);
+int crear_procesos(char *prog, unsigned int n, int *ids);
+int esperar_proceso(int id, int *estado);
+int terminar_proceso_estado(int estado);
+int crear_hilo(int (*funcion)(void *), void *arg);
+
+/* Lecturas de la pagina del sistema, sin llamadas al sistema */
+unsigned long long leer_ticks();
+unsigned long long leer_hora();
 
 #endif /* SERVICIOS_H */
 
@@ -76,6 +76,91 @@ ALGO COMENTE ESTA PARTE Y DESCOMENTE LA PRUEBA CORRESPONDIENTE */
 		printf("Error creando prueba_term\n");
 */
 
+/* PRUEBA DE PRIORIDADES
+	if (crear_proceso("prueba_prio")<0)
+		printf("Error creando prueba_prio\n");
+*/
+
+/* PRUEBA DE PLANIFICACION POR ZANCADAS (arrancando con PLANIFICADOR=stride)
+	if (crear_proceso("prueba_stride")<0)
+		printf("Error creando prueba_stride\n");
+*/
+
+/* PRUEBA DE LA CLASE DE TIEMPO REAL
+	if (crear_proceso("prueba_tiempo_real")<0)
+		printf("Error creando prueba_tiempo_real\n");
+*/
+
+/* PRUEBA DE CESION DE LA UCP
+	if (crear_proceso("prueba_ceder")<0)
+		printf("Error creando prueba_ceder\n");
+*/
+
+/* PRUEBA DE GRUPOS DE PROCESOS CON CUOTA DE UCP
+	if (crear_proceso("prueba_grupos")<0)
+		printf("Error creando prueba_grupos\n");
+*/
+
+/* PRUEBA DE LIMITES DE TIEMPO DE UCP
+	if (crear_proceso("prueba_limites")<0)
+		printf("Error creando prueba_limites\n");
+*/
+
+/* PRUEBA DE LA TAREA OCIOSA
+	if (crear_proceso("prueba_ocioso")<0)
+		printf("Error creando prueba_ocioso\n");
+*/
+
+/* PRUEBA DE DORMIR EN MILISEGUNDOS Y HASTA UN TICK
+	if (crear_proceso("prueba_dormir_ms")<0)
+		printf("Error creando prueba_dormir_ms\n");
+*/
+
+/* PRUEBA DE LA HOLGURA DE LOS DESPERTARES
+	if (crear_proceso("prueba_holgura")<0)
+		printf("Error creando prueba_holgura\n");
+*/
+
+/* PRUEBA DE LA PAGINA DEL SISTEMA
+	if (crear_proceso("prueba_reloj")<0)
+		printf("Error creando prueba_reloj\n");
+*/
+
+/* PRUEBA DE TEMPORIZADORES
+	if (crear_proceso("prueba_temporizadores")<0)
+		printf("Error creando prueba_temporizadores\n");
+*/
+
+/* PRUEBA DE LA TABLA DE PROCESOS
+	if (crear_proceso("prueba_procesos")<0)
+		printf("Error creando prueba_procesos\n");
+*/
+
+/* PRUEBA DE TASA DE CREACION DE PROCESOS
+	if (crear_proceso("prueba_creacion")<0)
+		printf("Error creando prueba_creacion\n");
+*/
+
+/* PRUEBA DE LA CACHE DE IMAGENES
+	if (crear_proceso("prueba_imagenes")<0)
+		printf("Error creando prueba_imagenes\n");
+*/
+
+/* PRUEBA DE CREACION DE PROCESOS POR LOTES
+	if (crear_proceso("prueba_lote")<0)
+		printf("Error creando prueba_lote\n");
+*/
+
+/* PRUEBA DE ESPERAR_PROCESO
+	if (crear_proceso("prueba_esperar")<0)
+		printf("Error creando prueba_esperar\n");
+*/
+
+/* PRUEBA DE HILOS
+	if (crear_proceso("prueba_hilos")<0)
+		printf("Error creando prueba_hilos\n");
+*/
+
 	printf("init: termina\n");
 	return 0; 
 }
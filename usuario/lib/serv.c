@@ -16,8 +16,10 @@
  *
  */
 
+#include <stdarg.h>
 #include "llamsis.h"
 #include "servicios.h"
+#include "pagina_sistema.h"
 
 /* Funci�n del m�dulo "misc" que prepara el c�digo de la llamada
    (en el registro 0), los par�metros (en registros 1, 2, ...), realiza la
@@ -26,6 +28,40 @@
 
 int llamsis(int llamada, int nargs, ... /* args */);
 
+/* Pagina del sistema, de solo lectura. El S.O. fija su direccion al
+   cargar el programa; mientras sea nula se usan llamadas al sistema */
+pagina_sistema_t *pagina_sistema = NULL;
+
+/* Ejecuta las funciones de los temporizadores que han vencido. Las
+   recoge de una en una, ya que una de ellas puede hacer llamadas que a su
+   vez atiendan los avisos restantes */
+static void atender_avisos(){
+    void (*funcion)(int);
+    int id;
+
+    while (pagina_sistema->avisos != 0 &&
+           llamsis(RECOGER_AVISO, 2, (long)&funcion, (long)&id) == 0)
+        funcion(id);
+}
+
+/* Realiza una llamada al sistema con llamsis (como mucho 3 argumentos)
+   y, al volver al proceso, atiende sus avisos de temporizador pendientes */
+static int llamar(int llamada, int nargs, ...){
+    long args[3] = {0, 0, 0};
+    va_list ap;
+    int i, res;
+
+    va_start(ap, nargs);
+    for (i = 0; i < nargs && i < 3; i++)
+        args[i] = va_arg(ap, long);
+    va_end(ap);
+
+    res = llamsis(llamada, nargs, args[0], args[1], args[2]);
+    if (pagina_sistema != NULL && pagina_sistema->avisos != 0)
+        atender_avisos();
+    return res;
+}
+
 
 /*
  *
@@ -35,47 +71,190 @@ int llamsis(int llamada, int nargs, ... /* args */);
 
 
 int crear_proceso(char *prog){
-	return llamsis(CREAR_PROCESO, 1, (long)prog);
+	return llamar(CREAR_PROCESO, 1, (long)prog);
 }
 
 int terminar_proceso(){
-	return llamsis(TERMINAR_PROCESO, 0);
+	return llamar(TERMINAR_PROCESO, 0);
 }
 
 int escribir(char *texto, unsigned int longi){
 
 
-	return llamsis(ESCRIBIR, 2, (long)texto, (long)longi);
+	return llamar(ESCRIBIR, 2, (long)texto, (long)longi);
 }
 
 int dormir(unsigned int segundos){
-    return llamsis(DORMIR, 1, (long)segundos);
+    return llamar(DORMIR, 1, (long)segundos);
 }
 
 int obtener_id_pr(){
-    return llamsis(OBTENER_ID_PR, 0);
+    if (pagina_sistema != NULL)
+        return pagina_sistema->id_actual;
+    return llamar(OBTENER_ID_PR, 0);
 }
 
 int crear_mutex(char *nombre, int tipo){
-    return llamsis(CREAR_MUTEX, 2, (long)nombre, (long)tipo);
+    return llamar(CREAR_MUTEX, 2, (long)nombre, (long)tipo);
 }
 
 int abrir_mutex(char *nombre){
-    return llamsis(ABRIR_MUTEX, 1, (long)nombre);
+    return llamar(ABRIR_MUTEX, 1, (long)nombre);
 }
 
 int lock(unsigned int mutexid){
-    return llamsis(LOCK,1, (long)mutexid);
+    return llamar(LOCK,1, (long)mutexid);
 }
 
 int unlock(unsigned int mutexid){
-    return llamsis(UNLOCK, 1, (long)mutexid);
+    return llamar(UNLOCK, 1, (long)mutexid);
 }
 
 int cerrar_mutex(unsigned int mutexid){
-    return llamsis(CERRAR_MUTEX, 1, (long)mutexid);
+    return llamar(CERRAR_MUTEX, 1, (long)mutexid);
 }
 
 int leer_caracter(){
-    return llamsis(LEER_CARACTER, 0);
-}
\ No newline at end of file
+    return llamar(LEER_CARACTER, 0);
+}
+
+int fijar_prioridad(int id, int prioridad){
+    return llamar(FIJAR_PRIORIDAD, 2, (long)id, (long)prioridad);
+}
+
+int fijar_tickets(int id, unsigned int tickets){
+    return llamar(FIJAR_TICKETS, 2, (long)id, (long)tickets);
+}
+
+int fijar_tiempo_real(unsigned int periodo, unsigned int presupuesto){
+    return llamar(FIJAR_TIEMPO_REAL, 2, (long)periodo, (long)presupuesto);
+}
+
+int esperar_periodo(){
+    return llamar(ESPERAR_PERIODO, 0);
+}
+
+int ceder_cpu(){
+    return llamar(CEDER_CPU, 0);
+}
+
+int ceder_a(int id){
+    return llamar(CEDER_A, 1, (long)id);
+}
+
+int crear_grupo(unsigned int cuota){
+    return llamar(CREAR_GRUPO, 1, (long)cuota);
+}
+
+int unir_grupo(int grupo){
+    return llamar(UNIR_GRUPO, 1, (long)grupo);
+}
+
+int leer_uso_grupo(int grupo){
+    return llamar(LEER_USO_GRUPO, 1, (long)grupo);
+}
+
+int fijar_limite_ucp(unsigned int blando, unsigned int duro){
+    return llamar(FIJAR_LIMITE_UCP, 2, (long)blando, (long)duro);
+}
+
+int leer_tiempo_ucp(int id){
+    return llamar(LEER_TIEMPO_UCP, 1, (long)id);
+}
+
+int leer_tiempo_ocioso(unsigned int *total){
+    return llamar(LEER_TIEMPO_OCIOSO, 1, (long)total);
+}
+
+int dormir_ms(unsigned int milisegundos){
+    return llamar(DORMIR_MS, 1, (long)milisegundos);
+}
+
+int dormir_hasta(unsigned long tick){
+    return llamar(DORMIR_HASTA, 1, (long)tick);
+}
+
+int fijar_holgura(unsigned int ticks){
+    return llamar(FIJAR_HOLGURA, 1, (long)ticks);
+}
+
+int obtener_ticks(){
+    return llamar(OBTENER_TICKS, 0);
+}
+
+int crear_temporizador(unsigned int milisegundos, unsigned int periodo_ms,
+                       void (*funcion)(int)){
+    return llamar(CREAR_TEMPORIZADOR, 3, (long)milisegundos,
+                  (long)periodo_ms, (long)funcion);
+}
+
+int esperar_temporizador(int id){
+    return llamar(ESPERAR_TEMPORIZADOR, 1, (long)id);
+}
+
+int cancelar_temporizador(int id){
+    return llamar(CANCELAR_TEMPORIZADOR, 1, (long)id);
+}
+
+int leer_cache_imagenes(unsigned int *fallos){
+    return llamar(LEER_CACHE_IMAGENES, 1, (long)fallos);
+}
+
+int crear_procesos(char *prog, unsigned int n, int *ids){
+    return llamar(CREAR_PROCESOS, 3, (long)prog, (long)n, (long)ids);
+}
+
+/*
+ *
+ * Funciones que leen la pagina del sistema sin llamadas al sistema
+ *
+ */
+
+unsigned long long leer_ticks(){
+    unsigned int secuencia;
+    unsigned long long ticks;
+
+    if (pagina_sistema == NULL)
+        return obtener_ticks();
+    do {
+        secuencia=pagina_sistema->secuencia;
+        ticks=pagina_sistema->ticks;
+    } while ((secuencia & 1) || secuencia!=pagina_sistema->secuencia);
+    return ticks;
+}
+
+unsigned long long leer_hora(){
+    unsigned int secuencia;
+    unsigned long long hora;
+
+    if (pagina_sistema == NULL)
+        return 0;
+    do {
+        secuencia=pagina_sistema->secuencia;
+        hora=pagina_sistema->hora;
+    } while ((secuencia & 1) || secuencia!=pagina_sistema->secuencia);
+    return hora;
+}
+
+int esperar_proceso(int id, int *estado){
+	return llamar(ESPERAR_PROCESO, 2, (long)id, (long)estado);
+}
+
+int terminar_proceso_estado(int estado){
+	return llamar(TERMINAR_PROCESO_ESTADO, 1, (long)estado);
+}
+
+/* Punto de entrada de los hilos: recoge su funcion y su argumento y
+   termina con el valor que devuelve la funcion */
+static int lanzar_hilo(){
+	int (*funcion)(void *);
+	void *arg;
+
+	if (llamar(ARGUMENTOS_HILO, 2, (long)&funcion, (long)&arg) == 0)
+		terminar_proceso_estado(funcion(arg));
+	return 0;
+}
+
+int crear_hilo(int (*funcion)(void *), void *arg){
+	return llamar(CREAR_HILO, 3, (long)lanzar_hilo, (long)funcion, (long)arg);
+}
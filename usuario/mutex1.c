@@ -31,7 +31,7 @@ int main() {
         printf("error en lock de mutex. NO DEBE APARECER\n");
     else printf("Se hace lock %d. Es el segundo.\n", desc);
 
-    printf("mutex1 duerme 2 segs.: no debe ejecutar ning�n proceso, ya que prueba_mutex est� dormido y mutex2 bloqueado en mutex m1\n");
+    printf("mutex1 duerme 2 segs.: no debe ejecutar ning�n proceso, ya que prueba_mutex est� esperando y mutex2 bloqueado en mutex m1\n");
     dormir(2);
 
     /* cierre de sem�foro: debe despertar a mutex2 */
@@ -0,0 +1,20 @@
+/*
+ * usuario/nulo.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que termina nada más empezar. Lo usa prueba_creacion
+ * para medir el coste de crear y terminar procesos.
+ */
+
+#include "servicios.h"
+
+int main(){
+	/* la llamada explicita enlaza la biblioteca, que aporta el punto de
+	   entrada del programa */
+	terminar_proceso();
+	return 0;
+}
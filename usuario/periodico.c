@@ -0,0 +1,40 @@
+/*
+ * usuario/periodico.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que simula un bucle de control periódico de tiempo
+ * real: pide un periodo de PERIODO ticks con PRESUPUESTO ticks de UCP y
+ * en cada activación hace un poco de trabajo y espera al siguiente periodo.
+ */
+
+#include "servicios.h"
+
+#define PERIODO 100		/* ticks */
+#define PRESUPUESTO 40		/* ticks */
+#define NUM_PERIODOS 10
+#define ITER_TRABAJO 200000
+
+int main(){
+	int i, j, id, fallos=0;
+	unsigned int tot=0;
+
+	id=obtener_id_pr();
+	if (fijar_tiempo_real(PERIODO, PRESUPUESTO)<0) {
+		printf("periodico (%d): no admitido\n", id);
+		return 0;
+	}
+	printf("periodico (%d): admitido\n", id);
+
+	for (i=0; i<NUM_PERIODOS; i++) {
+		for (j=0; j<ITER_TRABAJO; j++)
+			tot+=j;
+		fallos=esperar_periodo();
+	}
+
+	printf("periodico (%d): termina con %d fallos de plazo\n", id, fallos);
+	return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * usuario/proporcional.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que "gasta CPU" por bloques con una cuota de
+ * tickets que depende del orden en que se crea (1, 2, 3... veces
+ * TICKETS_DEFECTO). El primero en completar META bloques muestra cuántos
+ * ha completado cada uno, que deben guardar la misma proporción que los
+ * tickets si la planificación por zancadas está activa.
+ */
+
+#include "servicios.h"
+
+#define NUM_PROPORCIONALES 3	/* instancias que crea prueba_stride */
+#define META 60			/* bloques del proceso con más tickets */
+#define ITER_BLOQUE 1000000
+
+/* Todas las instancias de un programa comparten sus variables globales,
+   ya que el S.O. carga una sola vez cada ejecutable */
+static volatile int num_creados = 0;
+static volatile int progreso[NUM_PROPORCIONALES];
+static volatile int fin = 0;
+
+int main(){
+	int i, j, orden, id;
+	unsigned int tot=0;
+
+	id=obtener_id_pr();
+	orden=num_creados++;
+	if (orden>=NUM_PROPORCIONALES)
+		return 0;
+	if (fijar_tickets(id, TICKETS_DEFECTO*(orden+1))<0)
+		printf("proporcional (%d): error fijando tickets\n", id);
+
+	while (!fin) {
+		for (j=0; j<ITER_BLOQUE; j++)
+			tot+=j;
+		if (++progreso[orden]>=META)
+			fin=1;
+	}
+
+	if (progreso[orden]>=META)
+		for (i=0; i<NUM_PROPORCIONALES; i++)
+			printf("proporcional: %d tickets -> %d bloques (ideal %d)\n",
+				TICKETS_DEFECTO*(i+1), progreso[i],
+				META*(i+1)/NUM_PROPORCIONALES);
+
+	printf("proporcional (%d): termina con %u\n", id, tot);
+	return 0;
+}
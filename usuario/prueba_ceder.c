@@ -0,0 +1,46 @@
+/*
+ * usuario/prueba_ceder.c
+ *
+ *  Minikernel. Versin 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la cesin voluntaria de la UCP: con la
+ * prioridad mxima crea un proceso mudo y cede la UCP repetidamente, lo
+ * que con prioridades no debe dejar ejecutar al mudo, de menos prioridad.
+ * Despus crea dos procesos alternante que se pasan el turno con
+ * ceder_cpu y ceder_a. Debe terminar tambin con la poltica FIFO, que
+ * nunca expulsa.
+ */
+
+#include "servicios.h"
+
+#define CESIONES 100
+#define PRIORIDAD_ALTA 0	/* PRIORIDAD_MAXIMA del S.O. */
+#define PRIORIDAD_NORMAL 16	/* PRIORIDAD_DEFECTO del S.O. */
+
+int main(){
+	int i, id;
+	unsigned long long inicio;
+
+	printf("prueba_ceder: comienza\n");
+
+	id=obtener_id_pr();
+	fijar_prioridad(id, PRIORIDAD_ALTA);
+	if (crear_proceso("mudo")<0)
+		printf("Error creando mudo\n");
+	inicio=leer_ticks();
+	for (i=0; i<CESIONES; i++)
+		ceder_cpu();
+	printf("prueba_ceder: %d cesiones con mas prioridad en %d ticks (con prioridades debe ser 0)\n",
+	       CESIONES, (int)(leer_ticks()-inicio));
+	fijar_prioridad(id, PRIORIDAD_NORMAL);
+
+	for (i=1; i<=2; i++)
+		if (crear_proceso("alternante")<0)
+			printf("Error creando alternante\n");
+
+	printf("prueba_ceder: termina\n");
+	return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * usuario/prueba_creacion.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que mide la tasa de creación de procesos: crea
+ * RONDAS veces LOTE procesos nulo, que terminan nada más empezar, y entre
+ * ronda y ronda duerme para que terminen y la tarea ociosa recoja sus
+ * recursos. Se puede comparar la tasa con y sin reserva de pilas
+ * arrancando con RESERVA_PROCESOS=0.
+ */
+
+#include "servicios.h"
+
+#define RONDAS 5
+#define LOTE 500
+
+int main(){
+	int i, j, t, ticks=0;
+
+	printf("prueba_creacion: comienza\n");
+
+	for (i=1; i<=RONDAS; i++) {
+		t=obtener_ticks();
+		for (j=0; j<LOTE; j++)
+			if (crear_proceso("nulo")<0) {
+				printf("prueba_creacion: error creando nulo\n");
+				return 1;
+			}
+		t=obtener_ticks()-t;
+		ticks+=t;
+		printf("prueba_creacion: ronda %d, %d procesos en %d ticks\n",
+			i, LOTE, t);
+		dormir(1);
+	}
+
+	printf("prueba_creacion: %d procesos en %d ticks\n", RONDAS*LOTE, ticks);
+	printf("prueba_creacion: termina\n");
+	return 0;
+}
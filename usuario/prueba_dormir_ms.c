@@ -0,0 +1,55 @@
+/*
+ * usuario/prueba_dormir_ms.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba dormir_ms y dormir_hasta: ejecuta un
+ * bucle periódico de PERIODO ms que trabaja en cada activación y duerme
+ * hasta la siguiente con dormir_hasta, y compara el retraso final con el
+ * que acumula el mismo bucle usando dormir_ms.
+ */
+
+#include "servicios.h"
+
+#define PERIODO 50	/* ms (un tick por ms) */
+#define ACTIVACIONES 10
+#define ITER_TRABAJO 10000000
+
+static unsigned int trabajar(){
+	int j;
+	unsigned int tot=0;
+
+	for (j=0; j<ITER_TRABAJO; j++)
+		tot+=j;
+	return tot;
+}
+
+int main(){
+	int i, inicio, t;
+	unsigned int tot=0;
+
+	printf("prueba_dormir_ms: comienza\n");
+
+	inicio=t=dormir_hasta(0);
+	for (i=0; i<ACTIVACIONES; i++) {
+		tot+=trabajar();
+		t+=PERIODO;
+		dormir_hasta(t);
+	}
+	printf("prueba_dormir_ms: dormir_hasta, retraso %d ticks\n",
+		dormir_hasta(0)-inicio-ACTIVACIONES*PERIODO);
+
+	inicio=dormir_hasta(0);
+	for (i=0; i<ACTIVACIONES; i++) {
+		tot+=trabajar();
+		dormir_ms(PERIODO);
+	}
+	printf("prueba_dormir_ms: dormir_ms, retraso %d ticks\n",
+		dormir_hasta(0)-inicio-ACTIVACIONES*PERIODO);
+
+	printf("prueba_dormir_ms: termina con %u\n", tot);
+	return 0;
+}
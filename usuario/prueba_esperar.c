@@ -0,0 +1,58 @@
+/*
+ * usuario/prueba_esperar.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba esperar_proceso: espera a un hijo que
+ * aún no ha terminado, recoge a uno que ya es zombi, a uno que vuelve de
+ * main y a uno abortado por una excepción, y comprueba que no se puede
+ * esperar a un proceso que no es hijo ni recoger dos veces al mismo.
+ */
+
+#include "servicios.h"
+
+static void esperar(char *prog, int esperado, int dormido){
+	int id, estado;
+
+	if ((id=crear_proceso(prog))<0) {
+		printf("prueba_esperar: error creando %s\n", prog);
+		return;
+	}
+	if (dormido)
+		dormir(1);
+	if (esperar_proceso(id, &estado)<0)
+		printf("prueba_esperar: ERROR esperando a %s (%d)\n", prog, id);
+	else
+		printf("prueba_esperar: %s (%d) termina con %d en tick %d%s\n",
+			prog, id, estado, obtener_ticks(),
+			estado==esperado ? "" : " ERROR");
+
+	if (esperar_proceso(id, &estado)>=0)
+		printf("prueba_esperar: ERROR recogido dos veces %d\n", id);
+}
+
+int main(){
+	int id, estado;
+
+	printf("prueba_esperar: comienza en tick %d\n", obtener_ticks());
+
+	/* se bloquea hasta que el hijo termina, con su id como valor */
+	id=crear_proceso("finalizador");
+	if (esperar_proceso(id, &estado)<0 || estado!=id)
+		printf("prueba_esperar: ERROR esperando a finalizador\n");
+	printf("prueba_esperar: finalizador (%d) recogido con %d en tick %d\n",
+		id, estado, obtener_ticks());
+
+	esperar("nulo", 0, 1);
+	esperar("efimero", 0, 0);
+	esperar("excep_arit", ESTADO_FIN_ANORMAL, 0);
+
+	if (esperar_proceso(obtener_id_pr(), NULL)>=0)
+		printf("prueba_esperar: ERROR esperandose a si mismo\n");
+
+	printf("prueba_esperar: termina\n");
+	return 0;
+}
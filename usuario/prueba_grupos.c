@@ -0,0 +1,44 @@
+/*
+ * usuario/prueba_grupos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los grupos de procesos con cuota de
+ * UCP: crea tres procesos acaparador dentro de un grupo limitado al 20%
+ * de la UCP y otro fuera de él, y muestra el consumo del grupo.
+ */
+
+#include "servicios.h"
+
+#define CUOTA 20	/* ticks por periodo de PERIODO_GRUPOS (100) */
+
+int main(){
+	int i, grupo;
+
+	printf("prueba_grupos: comienza\n");
+
+	if ((grupo=crear_grupo(CUOTA))<0) {
+		printf("prueba_grupos: error creando grupo\n");
+		return 1;
+	}
+
+	/* los procesos creados heredan el grupo */
+	unir_grupo(grupo);
+	for (i=1; i<=3; i++)
+		if (crear_proceso("acaparador")<0)
+			printf("Error creando acaparador\n");
+	unir_grupo(-1);
+
+	if (crear_proceso("acaparador")<0)
+		printf("Error creando acaparador\n");
+
+	dormir(2);
+	printf("prueba_grupos: el grupo %d ha consumido %d ticks\n", grupo,
+		leer_uso_grupo(grupo));
+
+	printf("prueba_grupos: termina\n");
+	return 0;
+}
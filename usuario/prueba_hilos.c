@@ -0,0 +1,92 @@
+/*
+ * usuario/prueba_hilos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los hilos: TRABAJADORES hilos suman cada
+ * uno una parte de un vector global, que comparten con el proceso, y este
+ * los espera y combina sus resultados. Después compara el coste de crear
+ * un grupo de POOL hilos con el de crear POOL procesos nulo.
+ */
+
+#include "servicios.h"
+
+#define TRABAJADORES 8
+#define ELEMENTOS 8000
+#define POOL 500
+
+static int datos[ELEMENTOS];
+static int parciales[TRABAJADORES];
+
+static int sumar(void *arg){
+	int parte=(long)arg, i, suma=0;
+
+	for (i=parte*(ELEMENTOS/TRABAJADORES); i<(parte+1)*(ELEMENTOS/TRABAJADORES); i++)
+		suma+=datos[i];
+	parciales[parte]=suma;
+	return parte;
+}
+
+static int vacio(void *arg){
+	return 0;
+}
+
+/* espera a todos los creados y devuelve cuantos han terminado con 0 */
+static int esperar_todos(int *ids, int n){
+	int i, estado, correctos=0;
+
+	for (i=0; i<n; i++)
+		if (esperar_proceso(ids[i], &estado)==0 && estado==0)
+			correctos++;
+	return correctos;
+}
+
+int main(){
+	int ids[POOL];
+	int i, estado, suma=0, t, ticks_hilos, ticks_procesos;
+
+	printf("prueba_hilos: comienza\n");
+
+	for (i=0; i<ELEMENTOS; i++)
+		datos[i]=i;
+	for (i=0; i<TRABAJADORES; i++)
+		if ((ids[i]=crear_hilo(sumar, (void *)(long)i))<0)
+			printf("prueba_hilos: error creando el hilo %d\n", i);
+	for (i=0; i<TRABAJADORES; i++) {
+		if (esperar_proceso(ids[i], &estado)<0 || estado!=i)
+			printf("prueba_hilos: ERROR esperando al hilo %d\n", i);
+		suma+=parciales[i];
+	}
+	printf("prueba_hilos: %d hilos suman %d (debe ser %d)\n",
+		TRABAJADORES, suma, ELEMENTOS*(ELEMENTOS-1)/2);
+
+	/* con la maxima prioridad los creados no ejecutan hasta que se
+	   bloquea, de modo que solo se mide su creacion */
+	fijar_prioridad(obtener_id_pr(), 0);
+
+	t=obtener_ticks();
+	for (i=0; i<POOL; i++)
+		ids[i]=crear_hilo(vacio, NULL);
+	ticks_hilos=obtener_ticks()-t;
+	printf("prueba_hilos: %d de %d hilos terminan bien\n",
+		esperar_todos(ids, POOL), POOL);
+
+	t=obtener_ticks();
+	for (i=0; i<POOL; i++)
+		ids[i]=crear_proceso("nulo");
+	ticks_procesos=obtener_ticks()-t;
+	printf("prueba_hilos: %d de %d procesos terminan bien\n",
+		esperar_todos(ids, POOL), POOL);
+
+	printf("prueba_hilos: %d hilos en %d ticks, %d procesos en %d ticks\n",
+		POOL, ticks_hilos, POOL, ticks_procesos);
+
+	if (crear_hilo(NULL, NULL)>=0)
+		printf("prueba_hilos: ERROR creado un hilo sin funcion\n");
+
+	printf("prueba_hilos: termina\n");
+	return 0;
+}
@@ -0,0 +1,41 @@
+/*
+ * usuario/prueba_holgura.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la holgura de los despertares: crea
+ * cuatro procesos sondeador con despertares desfasados un tick, primero
+ * sin holgura (cuatro despertares por periodo) y después con una holgura
+ * de HOLGURA ticks (el núcleo los despierta en un único lote).
+ */
+
+#include "servicios.h"
+
+#define HOLGURA 4
+
+static void crear_sondeadores(){
+	int i;
+
+	for (i=1; i<=4; i++)
+		if (crear_proceso("sondeador")<0)
+			printf("Error creando sondeador\n");
+}
+
+int main(){
+	printf("prueba_holgura: comienza\n");
+
+	printf("prueba_holgura: sondeadores sin holgura\n");
+	fijar_holgura(0);
+	crear_sondeadores();
+	dormir(1);
+
+	printf("prueba_holgura: sondeadores con holgura %d\n", HOLGURA);
+	fijar_holgura(HOLGURA);
+	crear_sondeadores();
+
+	printf("prueba_holgura: termina\n");
+	return 0;
+}
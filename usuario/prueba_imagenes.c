@@ -0,0 +1,37 @@
+/*
+ * usuario/prueba_imagenes.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la cache de imágenes: crea PROCESOS
+ * procesos nulo seguidos. Solo el primero debe cargar el programa; el
+ * resto comparte su imagen mientras siga vivo algún proceso que la use.
+ */
+
+#include "servicios.h"
+
+#define PROCESOS 100
+
+int main(){
+	unsigned int fallos_ini, fallos;
+	int i, aciertos_ini, aciertos, t;
+
+	printf("prueba_imagenes: comienza\n");
+
+	aciertos_ini=leer_cache_imagenes(&fallos_ini);
+	t=obtener_ticks();
+	for (i=0; i<PROCESOS; i++)
+		if (crear_proceso("nulo")<0)
+			printf("prueba_imagenes: error creando nulo\n");
+	t=obtener_ticks()-t;
+	aciertos=leer_cache_imagenes(&fallos);
+
+	printf("prueba_imagenes: %d procesos en %d ticks: %d aciertos, %d fallos\n",
+		PROCESOS, t, aciertos-aciertos_ini, fallos-fallos_ini);
+
+	printf("prueba_imagenes: termina\n");
+	return 0;
+}
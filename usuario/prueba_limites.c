@@ -0,0 +1,33 @@
+/*
+ * usuario/prueba_limites.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los límites de tiempo de UCP: fija un
+ * límite blando y otro duro, que hereda el proceso desbocado que crea,
+ * y comprueba que no se puede ampliar el límite duro.
+ */
+
+#include "servicios.h"
+
+#define LIMITE_BLANDO 100	/* ticks */
+#define LIMITE_DURO 200
+
+int main(){
+	printf("prueba_limites: comienza\n");
+
+	if (fijar_limite_ucp(LIMITE_BLANDO, LIMITE_DURO)<0)
+		printf("prueba_limites: error fijando limites\n");
+	if (fijar_limite_ucp(0, 0)==0)
+		printf("prueba_limites: se ha quitado el limite duro. NO DEBE APARECER\n");
+
+	if (crear_proceso("desbocado")<0)
+		printf("Error creando desbocado\n");
+
+	printf("prueba_limites: termina tras %d ticks de UCP\n",
+		leer_tiempo_ucp(obtener_id_pr()));
+	return 0;
+}
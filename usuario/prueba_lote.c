@@ -0,0 +1,64 @@
+/*
+ * usuario/prueba_lote.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que compara la creación de LOTE procesos nulo con
+ * un bucle de crear_proceso y con una sola llamada crear_procesos, RONDAS
+ * veces cada una. Entre ronda y ronda espera a que terminen. Comprueba
+ * también que un lote imposible no crea ningún proceso.
+ */
+
+#include "servicios.h"
+
+#define RONDAS 5
+#define LOTE 500
+
+/* recoge los hijos de una ronda para que no se acumulen zombis */
+static void esperar_lote(int *ids){
+	int j;
+
+	for (j=0; j<LOTE; j++)
+		esperar_proceso(ids[j], NULL);
+}
+
+int main(){
+	int ids[LOTE];
+	int i, j, t, ticks_bucle=0, ticks_lote=0;
+
+	printf("prueba_lote: comienza\n");
+
+	/* con la maxima prioridad los nulo no ejecutan hasta que se bloquea, de
+	   modo que solo se mide su creacion */
+	fijar_prioridad(obtener_id_pr(), 0);
+
+	for (i=1; i<=RONDAS; i++) {
+		t=obtener_ticks();
+		for (j=0; j<LOTE; j++)
+			if ((ids[j]=crear_proceso("nulo"))<0)
+				printf("prueba_lote: error creando nulo\n");
+		ticks_bucle+=obtener_ticks()-t;
+		esperar_lote(ids);
+
+		t=obtener_ticks();
+		if (crear_procesos("nulo", LOTE, ids)!=LOTE)
+			printf("prueba_lote: error creando el lote\n");
+		ticks_lote+=obtener_ticks()-t;
+		esperar_lote(ids);
+	}
+	printf("prueba_lote: ultimo lote, ids %d a %d\n", ids[0], ids[LOTE-1]);
+
+	if (crear_procesos("no_existe", LOTE, ids)>=0)
+		printf("prueba_lote: ERROR creado un lote de un programa que no existe\n");
+
+	printf("prueba_lote: %d procesos con crear_proceso en %d ticks\n",
+		RONDAS*LOTE, ticks_bucle);
+	printf("prueba_lote: %d procesos con crear_procesos en %d ticks\n",
+		RONDAS*LOTE, ticks_lote);
+
+	printf("prueba_lote: termina\n");
+	return 0;
+}
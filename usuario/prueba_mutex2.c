@@ -14,6 +14,18 @@
 
 #include "servicios.h"
 
+/*
+ * Crea un proceso nulo y espera a que termine. Como nulo ejecuta despues
+ * de los procesos ya listos, antes ejecutan mutex1 y mutex2 hasta que se
+ * bloquean o se duermen.
+ */
+static void esperar_nulo() {
+    int hijo;
+
+    if ((hijo = crear_proceso("nulo")) < 0 || esperar_proceso(hijo, NULL) < 0)
+        printf("error esperando a nulo. NO DEBE APARECER\n");
+}
+
 int main() {
     int desc1, desc2;
 
@@ -50,23 +62,23 @@ int main() {
     if (crear_proceso("mutex2") < 0)
         printf("Error creando mutex2\n");
 
-    printf("prueba_mutex duerme 1 seg.: ejecutar�n los procesos mutex1 y mutex2 que se bloquear�n en lock de mutex\n");
-    dormir(1);
+    printf("prueba_mutex espera a un proceso nulo: ejecutar�n los procesos mutex1 y mutex2 que se bloquear�n en lock de mutex\n");
+    esperar_nulo();
 
     /* No debe despertar a nadie */
     if (unlock(desc2) < 0)
         printf("error en unlock de mutex. NO DEBE APARECER\n");
 
-    printf("prueba_mutex duerme 1 seg.: no ejecutar� ning�n proceso ya que los mutex est�n bloqueados\n");
-    dormir(1);
+    printf("prueba_mutex espera a un proceso nulo: no ejecutar� ning�n proceso ya que los mutex est�n bloqueados\n");
+    esperar_nulo();
 
     /* Debe despertar al proceso mutex1 */
     if (unlock(desc2) < 0)
         printf("error en unlock de mutex. NO DEBE APARECER\n");
 
-    printf("prueba_mutex duerme 1 seg.: debe ejecutar mutex1 ya que se ha liberado el mutex m2\n");
+    printf("prueba_mutex espera a un proceso nulo: debe ejecutar mutex1 ya que se ha liberado el mutex m2\n");
 
-    dormir(1);
+    esperar_nulo();
 
     printf("prueba_mutex termina: debe ejecutar mutex2 ya que el cierre impl�cito de m1 debe despertarlo y mutex1 est� dormido\n");
 
@@ -0,0 +1,42 @@
+/*
+ * usuario/prueba_ocioso.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que mide la utilización de la UCP con el tiempo
+ * que contabiliza la tarea ociosa: duerme un segundo, gasta UCP durante
+ * otro rato y muestra la utilización tras cada fase.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 1000000000
+
+static void mostrar_utilizacion(char *fase){
+	int ocioso;
+	unsigned int total;
+
+	ocioso=leer_tiempo_ocioso(&total);
+	printf("prueba_ocioso: tras %s, %d de %d ticks ociosos (utilizacion %d%%)\n",
+		fase, ocioso, total, total ? (int)((total-ocioso)*100/total) : 0);
+}
+
+int main(){
+	int i;
+	unsigned int tot=0;
+
+	printf("prueba_ocioso: comienza\n");
+
+	dormir(1);
+	mostrar_utilizacion("dormir");
+
+	for (i=0; i<TOT_ITER; i++)
+		tot+=i;
+	mostrar_utilizacion("calcular");
+
+	printf("prueba_ocioso: termina con %u\n", tot);
+	return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * usuario/prueba_prio.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la planificación por
+ * prioridades: crea varios procesos mudo y después uno urgente, que debe
+ * terminar el primero.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_prio: comienza\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("mudo")<0)
+			printf("Error creando mudo\n");
+
+	if (crear_proceso("urgente")<0)
+		printf("Error creando urgente\n");
+
+	printf("prueba_prio: termina\n");
+	return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * usuario/prueba_procesos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la tabla de procesos: crea PROCESOS
+ * procesos efimero que están vivos a la vez, midiendo los ticks que
+ * cuesta cada grupo de LOTE creaciones (no debe crecer con el número de
+ * procesos), y comprueba que el identificador de un proceso terminado no
+ * se confunde con el del proceso que reutiliza su entrada.
+ */
+
+#include "servicios.h"
+
+#define PROCESOS 500
+#define LOTE 100
+#define REUTILIZADOS 20
+
+int main(){
+	int ids[PROCESOS];
+	int i, n, id, primero=-1, ultimo=-1, t;
+
+	printf("prueba_procesos: comienza\n");
+
+	t=obtener_ticks();
+	for (i=1, n=0; i<=PROCESOS; i++) {
+		if ((id=crear_proceso("efimero"))<0) {
+			printf("prueba_procesos: error creando el proceso %d\n", i);
+			break;
+		}
+		ids[n++]=id;
+		if (primero<0)
+			primero=id;
+		if (i%LOTE==0) {
+			printf("prueba_procesos: %d procesos, %d ticks los ultimos %d\n",
+				i, obtener_ticks()-t, LOTE);
+			t=obtener_ticks();
+		}
+	}
+
+	/* espera a que terminen todos y crea mas procesos, que acaban
+	   reutilizando sus entradas con otra generacion */
+	for (i=0; i<n; i++)
+		esperar_proceso(ids[i], NULL);
+	for (i=1; i<=REUTILIZADOS; i++)
+		if ((id=crear_proceso("efimero"))>=0)
+			ultimo=id;
+	printf("prueba_procesos: primer id %d, ultimo id %d\n", primero, ultimo);
+	if (leer_tiempo_ucp(primero)>=0)
+		printf("prueba_procesos: ERROR el id %d sigue siendo valido\n",
+			primero);
+
+	printf("prueba_procesos: termina\n");
+	return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * usuario/prueba_reloj.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la página del sistema: compara los
+ * ticks y el identificador que lee de ella con los que devuelven las
+ * llamadas al sistema y mide lo que cuesta cada forma de obtenerlos (en
+ * ticks de obtener_ticks, que pone al día el reloj).
+ */
+
+#include "servicios.h"
+
+#define LECTURAS 1000000
+
+int main(){
+	int i, id=0, t, inicio;
+
+	printf("prueba_reloj: comienza\n");
+
+	dormir_ms(20);
+	printf("prueba_reloj: ticks %d por llamada, %d en la pagina\n",
+		obtener_ticks(), (int)leer_ticks());
+	printf("prueba_reloj: id %d, hora CMOS %d ms (modulo 1000000)\n",
+		obtener_id_pr(), (int)(leer_hora()%1000000));
+
+	inicio=obtener_ticks();
+	for (i=0; i<LECTURAS; i++)
+		id+=obtener_id_pr()+(int)leer_ticks();
+	t=obtener_ticks();
+	printf("prueba_reloj: %d lecturas de la pagina en %d ticks\n",
+		LECTURAS, t-inicio);
+
+	inicio=t;
+	for (i=0; i<LECTURAS; i++)
+		id+=obtener_ticks();
+	printf("prueba_reloj: %d llamadas obtener_ticks en %d ticks\n",
+		LECTURAS, obtener_ticks()-inicio);
+
+	printf("prueba_reloj: termina (%d)\n", id);
+	return 0;
+}
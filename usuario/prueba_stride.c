@@ -0,0 +1,28 @@
+/*
+ * usuario/prueba_stride.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que mide el reparto de UCP de la planificación por
+ * zancadas: crea tres procesos proporcional con 1, 2 y 3 veces los tickets
+ * por defecto. Requiere arrancar con la variable de entorno
+ * PLANIFICADOR=stride.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_stride: comienza\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("proporcional")<0)
+			printf("Error creando proporcional\n");
+
+	printf("prueba_stride: termina\n");
+	return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * usuario/prueba_temporizadores.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los temporizadores: un único proceso
+ * multiplexa un temporizador periódico con función, uno de una vez con
+ * función y uno periódico sin función cuyos vencimientos espera. Las
+ * funciones se ejecutan al volver de la siguiente llamada al sistema.
+ */
+
+#include "servicios.h"
+
+#define ESPERAS 5
+
+static int avisos_periodico=0;
+
+static void periodico(int id){
+	avisos_periodico++;
+	printf("prueba_temporizadores: aviso %d del periodico (%d) en tick %d\n",
+		avisos_periodico, id, (int)leer_ticks());
+}
+
+static void alarma(int id){
+	printf("prueba_temporizadores: alarma (%d) en tick %d\n",
+		id, (int)leer_ticks());
+}
+
+int main(){
+	int t_periodico, t_alarma, t_contador, i, n;
+
+	printf("prueba_temporizadores: comienza en tick %d\n", obtener_ticks());
+
+	t_periodico=crear_temporizador(50, 50, periodico);
+	t_alarma=crear_temporizador(120, 0, alarma);
+	t_contador=crear_temporizador(100, 100, NULL);
+	if (t_periodico<0 || t_alarma<0 || t_contador<0) {
+		printf("prueba_temporizadores: error creando temporizadores\n");
+		return 1;
+	}
+
+	for (i=1; i<=ESPERAS; i++) {
+		n=esperar_temporizador(t_contador);
+		printf("prueba_temporizadores: contador vence %d vez en tick %d\n",
+			n, obtener_ticks());
+	}
+
+	/* la alarma ya ha vencido y no se puede esperar un temporizador con
+	   funcion */
+	if (esperar_temporizador(t_alarma)>=0)
+		printf("prueba_temporizadores: ERROR esperando la alarma\n");
+
+	cancelar_temporizador(t_periodico);
+	cancelar_temporizador(t_contador);
+	printf("prueba_temporizadores: %d avisos del periodico en %d ms\n",
+		avisos_periodico, ESPERAS*100);
+
+	printf("prueba_temporizadores: termina\n");
+	return 0;
+}
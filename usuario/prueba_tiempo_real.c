@@ -0,0 +1,32 @@
+/*
+ * usuario/prueba_tiempo_real.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que realiza una prueba de la clase de tiempo real:
+ * crea procesos mudo y tres procesos periodico que piden un 40% de UCP
+ * cada uno. Los dos primeros deben ser admitidos y cumplir sus plazos a
+ * pesar de los mudo y el tercero debe ser rechazado.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int i;
+
+	printf("prueba_tiempo_real: comienza\n");
+
+	for (i=1; i<=2; i++)
+		if (crear_proceso("mudo")<0)
+			printf("Error creando mudo\n");
+
+	for (i=1; i<=3; i++)
+		if (crear_proceso("periodico")<0)
+			printf("Error creando periodico\n");
+
+	printf("prueba_tiempo_real: termina\n");
+	return 0;
+}
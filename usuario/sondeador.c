@@ -0,0 +1,39 @@
+/*
+ * usuario/sondeador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que sondea periódicamente: se despierta cada
+ * PERIODO ticks con un desfase de un tick respecto a la instancia
+ * anterior y acumula el retraso de cada despertar, que nunca debe
+ * superar la holgura que ha heredado.
+ */
+
+#include "servicios.h"
+
+#define NUM_DESFASES 4		/* instancias que crea cada vez prueba_holgura */
+#define PERIODO 20		/* ticks */
+#define SONDEOS 20
+
+/* Todas las instancias de un programa comparten sus variables globales,
+   ya que el S.O. carga una sola vez cada ejecutable */
+static volatile int num_creados = 0;
+
+int main(){
+	int i, t, despierta, retraso=0;
+
+	t=dormir_hasta(0);
+	t=(t/PERIODO+1)*PERIODO+(num_creados++)%NUM_DESFASES;
+	for (i=0; i<SONDEOS; i++) {
+		despierta=dormir_hasta(t);
+		retraso+=despierta-t;
+		t+=PERIODO;
+	}
+
+	printf("sondeador (%d): retraso total %d ticks en %d sondeos\n",
+		obtener_id_pr(), retraso, SONDEOS);
+	return 0;
+}
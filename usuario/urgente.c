@@ -0,0 +1,30 @@
+/*
+ * usuario/urgente.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ */
+
+/*
+ * Programa de usuario que se asigna la máxima prioridad y "gasta CPU".
+ * Debe terminar antes que los procesos de prioridad por defecto aunque
+ * se cree después que ellos.
+ */
+
+#include "servicios.h"
+
+#define TOT_ITER 20000000	/* ponga las que considere oportuno */
+
+int main(){
+	int i, tot, id;
+	int j=5;
+
+	id=obtener_id_pr();
+	if (fijar_prioridad(id, PRIORIDAD_MAXIMA)<0)
+		printf("urgente (%d): error fijando prioridad\n", id);
+
+	for (i=0; i<TOT_ITER; i++)
+		tot=j*i;
+	printf("urgente (%d): termina con %d\n", id, tot);
+	return 0;
+}